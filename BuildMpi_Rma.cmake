@@ -0,0 +1,7 @@
+find_package(MPI REQUIRED)
+list(APPEND mpi_rma_include_directories ${MPI_CXX_INCLUDE_PATH})
+list(APPEND mpi_rma_compile_options ${MPI_CXX_COMPILE_FLAGS})
+list(APPEND mpi_rma_link_libraries ${MPI_CXX_LIBRARIES} ${MPI_CXX_LINK_FLAGS})
+
+set(BLOCK_FILES ${BLOCKS}/SWE_Block.hh ${BLOCKS}/SWE_DimensionalSplittingMpi.hh ${BLOCKS}/SWE_DimensionalSplittingMpi.cpp ${BLOCKS}/SWE_DimensionalSplittingMpiRma.hh ${BLOCKS}/SWE_DimensionalSplittingMpiRma.cpp)
+set(EXAMPLE_FILES ${EXAMPLES}/swe_mpi.cpp)
@@ -104,9 +104,18 @@
 #include <limits>
 #include <algorithm>
 #include "tools/Float2DBuffer.hh"
+#include "tools/Float2DInterleaved.hh"
+#include "tools/SimulationTime.hh"
 #include <iostream>
 #include <iomanip>
 #include <math.h>
+
+// Only SWE_DimensionalSplitting (which includes this header behind its include guard) handles padded columns,
+// the other blocks exchange their ghost layers with a column stride of ny + 2.
+#if defined(PADDED_COLUMNS) && !defined(SWEDIMENSIONALSPLITTING_HH_)
+#error "PADDED_COLUMNS is only supported by SWE_DimensionalSplitting"
+#endif
+
 template<typename T, typename Buffer = Float2DBuffer>
 class SWE_Block {
 public:
@@ -144,17 +153,17 @@ public:
     //Methods for local timestepping
     void checkAllGhostlayers();
 
-    float getRoundTimestep(float timestep);
+    TimeScalar getRoundTimestep(TimeScalar timestep);
 
     void setMaxGlobalTimestep(float timestep);
 
-    void interpolateGhostlayer(Boundary border, float remoteTimestep);
+    void interpolateGhostlayer(Boundary border, TimeScalar remoteTimestep);
 
-    float interpolateValue(float oldval, float newval, float remoteTimestep,Boundary boundary);
+    float interpolateValue(float oldval, float newval, TimeScalar remoteTimestep,Boundary boundary);
 
-    float getTotalLocalTimestep();
+    TimeScalar getTotalLocalTimestep();
 
-    void setMaxLocalTimestep(float timestep);
+    void setMaxLocalTimestep(TimeScalar timestep);
 
     void printLtsStats();
 
@@ -211,13 +220,13 @@ public:
     // maximum time step allowed to ensure stability of the method
     // it may be updated as part of the method computeNumericalFluxes()
     // or updateUnknowns() (depending on the numerical method)
-    float duration;
+    TimeScalar duration;
 
-    void setDuration(float duration);
+    void setDuration(TimeScalar duration);
 
     float maxTimestep;
-    float maxTimestepLocal; // used for local timestepping
-    float currentTimestep = 0;
+    TimeScalar maxTimestepLocal; // used for local timestepping
+    TimeScalar currentTimestep = 0;
     int maxDivisor = 1024; //smallest timestep possible maxTimestepLocal/maxDivisor
     bool localTimestepping; //true to activate localtimestepping
     bool notifiedLastTimestep = false;
@@ -225,7 +234,7 @@ public:
     int stepSizeCounter; //used to count the steps;
     void resetStepSizeCounter();
     GhostlayerState receivedGhostlayer[4]; //determines if border received a valid timestep, thus is bigger or same then localtimestep.
-    float borderTimestep[4]; //timesteps of each border are put in here
+    TimeScalar borderTimestep[4]; //timesteps of each border are put in here
     int timestepCounter = 0;
     int myRank;
     int neighbourRankId[4];
@@ -233,6 +242,9 @@ public:
     void connectNeighbours(int neighbourRankId[]);
     void setRank(int rank);
 
+    // All arrays of the block are allocated from the arena, has to be declared before them
+    tools::BlockArena arena;
+
     // Unknowns
     T h;
     T hu;
@@ -285,14 +297,16 @@ SWE_Block<T, Buffer>::SWE_Block(int nx, int ny, float dx, float dy, float origin
         dy(dy),
         originX(originX),
         originY(originY),
-        h(nx + 2, ny + 2),
-        hu(nx + 2, ny + 2),
-        hv(nx + 2, ny + 2),
-        b(nx + 2, ny + 2),
+        arena(nx + 2, ny + 2),
+        // hu, hv and b share the cells of h with the interleaved layout (components 1, 2 and 3)
+        h(nx + 2, ny + 2, arena),
+        hu(tools::companionArray(h, 1, arena)),
+        hv(tools::companionArray(h, 2, arena)),
+        b(tools::companionArray(h, 3, arena)),
         localTimestepping(localTimestepping),
-        bufferH(nx + 2, ny + 2, localTimestepping, h),
-        bufferHu(nx + 2, ny + 2, localTimestepping, hu),
-        bufferHv(nx + 2, ny + 2, localTimestepping, hv) {
+        bufferH(nx + 2, ny + 2, localTimestepping, h, arena),
+        bufferHu(tools::companionBuffer(bufferH, 1, localTimestepping, hu, arena)),
+        bufferHv(tools::companionBuffer(bufferH, 2, localTimestepping, hv, arena)) {
     // initialise boundaries
     for (int i = 0; i < 4; i++) {
         boundaryType[i] = PASSIVE;
@@ -367,7 +381,7 @@ bool SWE_Block<T, Buffer>::isReceivable(Boundary border) {
 }
 
 template<typename T, typename Buffer>
-float SWE_Block<T, Buffer>::interpolateValue(float oldval, float newval, float remoteTimestep, Boundary boundary) {
+float SWE_Block<T, Buffer>::interpolateValue(float oldval, float newval, TimeScalar remoteTimestep, Boundary boundary) {
 
     return (oldval + (newval - oldval) * (getTotalLocalTimestep() / remoteTimestep));
 }
@@ -381,7 +395,7 @@ void SWE_Block<T, Buffer>::checkAllGhostlayers() {
         for (int border = BND_LEFT; border <= BND_TOP; border++) {
             if ((boundaryType[border] == CONNECT) || boundaryType[border] == CONNECT_WITHIN_RANK) {
 
-                if (std::fabs(borderTimestep[border]-getTotalLocalTimestep()) <= std::numeric_limits<double>::epsilon()) {
+                if (timesEqual(borderTimestep[border], getTotalLocalTimestep())) {
                     //This case the neighbor progressed as much as local block did and thus the received Ghostlayer is valid and we can expect
                     // a new timestep incoming in the next iteration.
                     //interpolateGhostlayer(static_cast<Boundary>(border), borderTimestep[border]);
@@ -403,7 +417,7 @@ void SWE_Block<T, Buffer>::checkAllGhostlayers() {
                 }
             }
         }
-        if(std::fabs(duration-getTotalLocalTimestep()) <= std::numeric_limits<double>::epsilon() || getTotalLocalTimestep()>= duration){
+        if(timesEqual(duration, getTotalLocalTimestep()) || getTotalLocalTimestep()>= duration){
             //notify neighbours that we have finished computation;
             notifiedLastTimestep = true;
         }
@@ -436,7 +450,7 @@ void SWE_Block<T, Buffer>::checkAllGhostlayers() {
 }
 
 template<typename T, typename Buffer>
-void SWE_Block<T, Buffer>::interpolateGhostlayer(Boundary border, float remoteTimestep) {
+void SWE_Block<T, Buffer>::interpolateGhostlayer(Boundary border, TimeScalar remoteTimestep) {
 
     switch (border) {
         case BND_LEFT:
@@ -480,30 +494,20 @@ void SWE_Block<T, Buffer>::interpolateGhostlayer(Boundary border, float remoteTi
 
 template<typename T, typename Buffer>
 void SWE_Block<T, Buffer>::copyGhostlayer(Boundary border) {
-    int startIndex;
-    int endIndex;
     switch (border) {
         case BND_LEFT:
-            startIndex = 1;
-            endIndex = startIndex + ny;
-
-            std::copy(bufferH.getRawPointer() + startIndex, bufferH.getRawPointer() + endIndex,
-                      h.getRawPointer() + startIndex);
-            std::copy(bufferHu.getRawPointer() + startIndex, bufferHu.getRawPointer() + endIndex,
-                      hu.getRawPointer() + startIndex);
-            std::copy(bufferHv.getRawPointer() + startIndex, bufferHv.getRawPointer() + endIndex,
-                      hv.getRawPointer() + startIndex);
+            for (int j = 1; j < ny + 1; j++) {
+                h[0][j] = bufferH[0][j];
+                hu[0][j] = bufferHu[0][j];
+                hv[0][j] = bufferHv[0][j];
+            }
             break;
         case BND_RIGHT:
-            startIndex = (nx + 1) * (ny + 2) + 1;
-            endIndex = startIndex + ny;
-
-            std::copy(bufferH.getRawPointer() + startIndex, bufferH.getRawPointer() + endIndex,
-                      h.getRawPointer() + startIndex);
-            std::copy(bufferHu.getRawPointer() + startIndex, bufferHu.getRawPointer() + endIndex,
-                      hu.getRawPointer() + startIndex);
-            std::copy(bufferHv.getRawPointer() + startIndex, bufferHv.getRawPointer() + endIndex,
-                      hv.getRawPointer() + startIndex);
+            for (int j = 1; j < ny + 1; j++) {
+                h[nx + 1][j] = bufferH[nx + 1][j];
+                hu[nx + 1][j] = bufferHu[nx + 1][j];
+                hv[nx + 1][j] = bufferHv[nx + 1][j];
+            }
             break;
         case BND_BOTTOM:
             for (int i = 1; i < nx + 1; i++) {
@@ -524,7 +528,7 @@ void SWE_Block<T, Buffer>::copyGhostlayer(Boundary border) {
 }
 
 template<typename T, typename Buffer>
-void SWE_Block<T, Buffer>::setMaxLocalTimestep(float timestep) {
+void SWE_Block<T, Buffer>::setMaxLocalTimestep(TimeScalar timestep) {
     maxTimestepLocal = timestep;
 }
 template<typename T, typename Buffer>
@@ -534,11 +538,11 @@ void SWE_Block<T, Buffer>::resetStepSizeCounter() {
     timestepCounter++;
 }
 template<typename T, typename Buffer>
-float SWE_Block<T, Buffer>::getRoundTimestep(float timestep) {
+TimeScalar SWE_Block<T, Buffer>::getRoundTimestep(TimeScalar timestep) {
 
     if (stepSizeCounter <= 0) {
         if(timestep > maxTimestepLocal) timestep = maxTimestepLocal;
-        if(timestep < (float) maxTimestepLocal/maxDivisor) timestep = (float) maxTimestepLocal/maxDivisor;
+        if(timestep < maxTimestepLocal/maxDivisor) timestep = maxTimestepLocal/maxDivisor;
 
         int divisor = pow(2,-(ceil(log(timestep)/log(2))));
         if((float)1.f/divisor > timestep)divisor*=2;
@@ -550,15 +554,15 @@ float SWE_Block<T, Buffer>::getRoundTimestep(float timestep) {
     }
     //stepSize = 32;
     //currentTimestep +=  (float) maxTimestepLocal / stepSize;
-    return (float) maxTimestepLocal / stepSize;
+    return maxTimestepLocal / stepSize;
 
 }
 
 template<typename T, typename Buffer>
-float SWE_Block<T, Buffer>::getTotalLocalTimestep() {
+TimeScalar SWE_Block<T, Buffer>::getTotalLocalTimestep() {
     //std::cout << "stepsize " << stepSize << std::endl;
    // return currentTimestep;
-    return (float) (maxTimestepLocal*timestepCounter)+(stepSize>0?((float)(maxTimestepLocal * stepSizeCounter) / (float)stepSize):0);
+    return (maxTimestepLocal*timestepCounter)+(stepSize>0?((maxTimestepLocal * stepSizeCounter) / stepSize):0);
 }
 
 template<typename T, typename Buffer>
@@ -725,10 +729,14 @@ template<typename T, typename Buffer>
 void SWE_Block<T, Buffer>::applyBoundaryBathymetry() {
     // set bathymetry values in the ghost layer if necessary
     if (boundaryType[BND_LEFT] == OUTFLOW || boundaryType[BND_LEFT] == WALL) {
-        memcpy(b[0], b[1], sizeof(float) * (ny + 2));
+        for (int j = 0; j <= ny + 1; j++) {
+            b[0][j] = b[1][j];
+        }
     }
     if (boundaryType[BND_RIGHT] == OUTFLOW || boundaryType[BND_RIGHT] == WALL) {
-        memcpy(b[nx + 1], b[nx], sizeof(float) * (ny + 2));
+        for (int j = 0; j <= ny + 1; j++) {
+            b[nx + 1][j] = b[nx][j];
+        }
     }
     if (boundaryType[BND_BOTTOM] == OUTFLOW || boundaryType[BND_BOTTOM] == WALL) {
         for (int i = 0; i <= nx + 1; i++) {
@@ -911,7 +919,7 @@ void SWE_Block<T, Buffer>::applyBoundaryConditions() {
 }
 
 template<typename T, typename Buffer>
-void SWE_Block<T, Buffer>::setDuration(float duration) {
+void SWE_Block<T, Buffer>::setDuration(TimeScalar duration) {
    this->duration = duration;
 }
 
@@ -49,8 +49,10 @@
  * @param l_ny Size of the computational domain in y-direction
  * @param l_dx Cell width
  * @param l_dy Cell height
+ * @param tileSize Edge length of the tiles both sweeps are computed on, 0 disables tiling
  */
-SWE_DimensionalSplitting::SWE_DimensionalSplitting(int nx, int ny, float dx, float dy, float originX, float originY) :
+SWE_DimensionalSplitting::SWE_DimensionalSplitting(int nx, int ny, float dx, float dy, float originX, float originY,
+                                                   int tileSize) :
 /*
  * Important note concerning grid allocations:
  * Since index shifts all over the place are bug-prone and maintenance unfriendly,
@@ -64,9 +66,11 @@ SWE_DimensionalSplitting::SWE_DimensionalSplitting(int nx, int ny, float dx, flo
 // Initialize grid metadata using the base class constructor
         SWE_Block(nx, ny, dx, dy, originX, originY),
 
+        tileSize(tileSize),
+
         // intermediate state Q after x-sweep
-        hStar(nx + 1, ny + 2),
-        huStar(nx + 1, ny + 2),
+        hStar(nx + 1, ny + 2, arena),
+        huStar(nx + 1, ny + 2, arena),
 
         /*
          * Temporary storage for the net updates per grid cell during a sweep.
@@ -76,18 +80,25 @@ SWE_DimensionalSplitting::SWE_DimensionalSplitting(int nx, int ny, float dx, flo
          */
 
         // For the x-sweep
-        hNetUpdatesLeft(nx + 2, ny + 2),
-        hNetUpdatesRight(nx + 2, ny + 2),
+        hNetUpdatesLeft(nx + 2, ny + 2, arena),
+        hNetUpdatesRight(nx + 2, ny + 2, arena),
 
-        huNetUpdatesLeft(nx + 2, ny + 2),
-        huNetUpdatesRight(nx + 2, ny + 2),
+        huNetUpdatesLeft(nx + 2, ny + 2, arena),
+        huNetUpdatesRight(nx + 2, ny + 2, arena),
 
         // For the y-sweep
-        hNetUpdatesBelow(nx + 1, ny + 2),
-        hNetUpdatesAbove(nx + 1, ny + 2),
+        hNetUpdatesBelow(nx + 1, ny + 2, arena),
+        hNetUpdatesAbove(nx + 1, ny + 2, arena),
+
+        hvNetUpdatesBelow(nx + 1, ny + 2, arena),
+        hvNetUpdatesAbove(nx + 1, ny + 2, arena) {
 
-        hvNetUpdatesBelow(nx + 1, ny + 2),
-        hvNetUpdatesAbove(nx + 1, ny + 2) {
+#if defined(TILED_LAYOUT)
+    // Cache tiles consist of whole storage tiles, both start at index 0
+    const int storageTile = std::max(Float2DLayout::tileCols, Float2DLayout::tileRows);
+    if (tileSize > 0)
+        this->tileSize = (tileSize + storageTile - 1) / storageTile * storageTile;
+#endif
 
     computeTime = 0.;
     computeTimeWall = 0.;
@@ -113,20 +124,66 @@ void SWE_DimensionalSplitting::computeNumericalFluxes() {
 
 #pragma omp parallel private(solver)
     {
-        // x-sweep, compute the actual domain plus ghost rows above and below
-        // iterate over cells on the x-axis, leave out the last column (two cells per computation)
+        if (tileSize > 0) {
+            /*
+             * Cache-blocked schedule: the edges are partitioned into tiles of tileSize x tileSize cells,
+             * the x- and y-sweep of a tile are computed together, so the tile (plus a one-cell halo)
+             * is only loaded once. The Q* update depends on the global timestep and follows below.
+             */
+            const int tilesX = (nx + 1 + tileSize - 1) / tileSize;
+            const int tilesY = (ny + 2 + tileSize - 1) / tileSize;
+
+#pragma omp for reduction(max : maxHorizontalWaveSpeed, maxVerticalWaveSpeed) collapse(2) schedule(dynamic)
+            for (int tileX = 0; tileX < tilesX; tileX++) {
+                for (int tileY = 0; tileY < tilesY; tileY++) {
+                    const int xBegin = tileX * tileSize;
+                    const int yBegin = tileY * tileSize;
+                    computeTileNetUpdates(solver, xBegin, std::min(xBegin + tileSize, nx + 1),
+                                                  yBegin, std::min(yBegin + tileSize, ny + 2),
+                                                  maxHorizontalWaveSpeed, maxVerticalWaveSpeed);
+                }
+            }
+        } else {
+            // x-sweep, compute the actual domain plus ghost rows above and below
+            // iterate over cells on the x-axis, leave out the last column (two cells per computation)
 #pragma omp for reduction(max : maxHorizontalWaveSpeed) collapse(2)
-        for (int x = 0; x < nx + 1; x++) {
-            // iterate over all rows, including ghost layer
-            for (int y = 0; y < ny + 2; y++) {
-                solver.computeNetUpdates(
-                        h[x][y], h[x + 1][y],
-                        hu[x][y], hu[x + 1][y],
-                        b[x][y], b[x + 1][y],
-                        hNetUpdatesLeft[x][y], hNetUpdatesRight[x + 1][y],
-                        huNetUpdatesLeft[x][y], huNetUpdatesRight[x + 1][y],
-                        maxHorizontalWaveSpeed
-                );
+            for (int x = 0; x < nx + 1; x++) {
+                // iterate over all rows, including ghost layer
+                for (int y = 0; y < ny + 2; y++) {
+                    const long left = h.offset(x, y);
+                    const long right = h.offset(x + 1, y);
+                    float maxEdgeSpeed;
+
+                    solver.computeNetUpdates(
+                            h.at(left), h.at(right),
+                            hu.at(left), hu.at(right),
+                            b.at(left), b.at(right),
+                            hNetUpdatesLeft.at(left), hNetUpdatesRight.at(right),
+                            huNetUpdatesLeft.at(left), huNetUpdatesRight.at(right),
+                            maxEdgeSpeed
+                    );
+                    maxHorizontalWaveSpeed = std::max(maxHorizontalWaveSpeed, maxEdgeSpeed);
+                }
+            }
+
+            // y-sweep
+#pragma omp for reduction(max : maxVerticalWaveSpeed) collapse(2)
+            for (int x = 1; x < nx + 1; x++) {
+                for (int y = 0; y < ny + 1; y++) {
+                    const long below = h.offset(x, y);
+                    const long above = h.offset(x, y + 1);
+                    float maxEdgeSpeed;
+
+                    solver.computeNetUpdates(
+                            h.at(below), h.at(above),
+                            hv.at(below), hv.at(above),
+                            b.at(below), b.at(above),
+                            hNetUpdatesBelow.at(below), hNetUpdatesAbove.at(above),
+                            hvNetUpdatesBelow.at(below), hvNetUpdatesAbove.at(above),
+                            maxEdgeSpeed
+                    );
+                    maxVerticalWaveSpeed = std::max(maxVerticalWaveSpeed, maxEdgeSpeed);
+                }
             }
         }
 
@@ -140,23 +197,9 @@ void SWE_DimensionalSplitting::computeNumericalFluxes() {
 #pragma omp for collapse(2)
         for (int x = 1; x < nx + 1; x++) {
             for (int y = 0; y < ny + 2; y++) {
-                hStar[x][y] = h[x][y] - (maxTimestep / dx) * (hNetUpdatesLeft[x][y] + hNetUpdatesRight[x][y]);
-                huStar[x][y] = hu[x][y] - (maxTimestep / dx) * (huNetUpdatesLeft[x][y] + huNetUpdatesRight[x][y]);
-            }
-        }
-
-        // y-sweep
-#pragma omp for reduction(max : maxVerticalWaveSpeed) collapse(2)
-        for (int x = 1; x < nx + 1; x++) {
-            for (int y = 0; y < ny + 1; y++) {
-                solver.computeNetUpdates(
-                        h[x][y], h[x][y + 1],
-                        hv[x][y], hv[x][y + 1],
-                        b[x][y], b[x][y + 1],
-                        hNetUpdatesBelow[x][y], hNetUpdatesAbove[x][y + 1],
-                        hvNetUpdatesBelow[x][y], hvNetUpdatesAbove[x][y + 1],
-                        maxVerticalWaveSpeed
-                );
+                const long cell = h.offset(x, y);
+                hStar.at(cell) = h.at(cell) - (maxTimestep / dx) * (hNetUpdatesLeft.at(cell) + hNetUpdatesRight.at(cell));
+                huStar.at(cell) = hu.at(cell) - (maxTimestep / dx) * (huNetUpdatesLeft.at(cell) + huNetUpdatesRight.at(cell));
             }
         }
 
@@ -178,6 +221,53 @@ void SWE_DimensionalSplitting::computeNumericalFluxes() {
     computeTimeWall += (float) (endTime.tv_nsec - startTime.tv_nsec) / 1E9;
 }
 
+/**
+ * Computes the net updates of all edges whose left (x-sweep) or lower (y-sweep) cell lies in the tile
+ * [xBegin, xEnd) x [yBegin, yEnd), the cells right of and above the tile are read as halo.
+ * The tiles partition the edges, so every net update is written exactly once.
+ */
+void SWE_DimensionalSplitting::computeTileNetUpdates(solver::Hybrid<float> &tileSolver,
+                                                     int xBegin, int xEnd, int yBegin, int yEnd,
+                                                     float &maxHorizontalWaveSpeed, float &maxVerticalWaveSpeed) {
+    // x-sweep, edges between x and x + 1 for x in [0, nx]
+    for (int x = xBegin; x < xEnd; x++) {
+        for (int y = yBegin; y < yEnd; y++) {
+            const long left = h.offset(x, y);
+            const long right = h.offset(x + 1, y);
+            float maxEdgeSpeed;
+
+            tileSolver.computeNetUpdates(
+                    h.at(left), h.at(right),
+                    hu.at(left), hu.at(right),
+                    b.at(left), b.at(right),
+                    hNetUpdatesLeft.at(left), hNetUpdatesRight.at(right),
+                    huNetUpdatesLeft.at(left), huNetUpdatesRight.at(right),
+                    maxEdgeSpeed
+            );
+            maxHorizontalWaveSpeed = std::max(maxHorizontalWaveSpeed, maxEdgeSpeed);
+        }
+    }
+
+    // y-sweep, edges between y and y + 1 for x in [1, nx] and y in [0, ny]
+    for (int x = std::max(xBegin, 1); x < xEnd; x++) {
+        for (int y = yBegin; y < std::min(yEnd, ny + 1); y++) {
+            const long below = h.offset(x, y);
+            const long above = h.offset(x, y + 1);
+            float maxEdgeSpeed;
+
+            tileSolver.computeNetUpdates(
+                    h.at(below), h.at(above),
+                    hv.at(below), hv.at(above),
+                    b.at(below), b.at(above),
+                    hNetUpdatesBelow.at(below), hNetUpdatesAbove.at(above),
+                    hvNetUpdatesBelow.at(below), hvNetUpdatesAbove.at(above),
+                    maxEdgeSpeed
+            );
+            maxVerticalWaveSpeed = std::max(maxVerticalWaveSpeed, maxEdgeSpeed);
+        }
+    }
+}
+
 /**
  * Updates the unknowns with the already computed net-updates.
  *
@@ -194,9 +284,10 @@ void SWE_DimensionalSplitting::updateUnknowns(float dt) {
     //update cell averages with the net-updates
     for (int x = 1; x < nx + 1; x++) {
         for (int y = 1; y < ny + 1; y++) {
-            h[x][y] = hStar[x][y] - (maxTimestep / dx) * (hNetUpdatesBelow[x][y] + hNetUpdatesAbove[x][y]);
-            hu[x][y] = huStar[x][y];
-            hv[x][y] = hv[x][y] - (maxTimestep / dx) * (hvNetUpdatesBelow[x][y] + hvNetUpdatesAbove[x][y]);
+            const long cell = h.offset(x, y);
+            h.at(cell) = hStar.at(cell) - (maxTimestep / dx) * (hNetUpdatesBelow.at(cell) + hNetUpdatesAbove.at(cell));
+            hu.at(cell) = huStar.at(cell);
+            hv.at(cell) = hv.at(cell) - (maxTimestep / dx) * (hvNetUpdatesBelow.at(cell) + hvNetUpdatesAbove.at(cell));
         }
     }
 
@@ -25,6 +25,10 @@
  * It extends the computational domain to two dimensions by decomposing 2D updates
  * to updates on the x- and y-axis.
  *
+ * The array layout is selected at compile time: Float2DNative (column-major) by default,
+ * Float2DTiled (tiles of 4 x 16 cells stored contiguously) with TILED_LAYOUT.
+ * All arrays of the block have ny + 2 rows, so the sweeps compute the offset() of a cell once in h
+ * and access every array at() that offset.
  */
 
 #ifndef SWEDIMENSIONALSPLITTING_HH_
@@ -33,16 +37,28 @@
 #include "blocks/SWE_Block.hh"
 #include "scenarios/SWE_Scenario.hh"
 #include "tools/Float2DNative.hh"
+#include "tools/Float2DBuffer.hh"
+#if defined(TILED_LAYOUT)
+#include "tools/Float2DTiled.hh"
+#endif
 #include <ctime>
 #include <time.h>
 
 #include "solvers/Hybrid.hpp"
 
-class SWE_DimensionalSplitting : public SWE_Block<Float2DNative> {
+#if defined(TILED_LAYOUT)
+typedef Float2DTiled Float2DLayout;
+typedef Float2DTiledBuffer Float2DLayoutBuffer;
+#else
+typedef Float2DNative Float2DLayout;
+typedef Float2DBuffer Float2DLayoutBuffer;
+#endif
+
+class SWE_DimensionalSplitting : public SWE_Block<Float2DLayout, Float2DLayoutBuffer> {
 public:
     // Constructor/Destructor
     SWE_DimensionalSplitting(int cellCountHorizontal, int cellCountVertical, float cellSizeHorizontal,
-                             float cellSizeVertical, float originX, float originY);
+                             float cellSizeVertical, float originX, float originY, int tileSize = 0);
 
     ~SWE_DimensionalSplitting() {};
 
@@ -57,24 +73,31 @@ public:
     float computeTimeWall;
 
 private:
+    // Solves all edges of the given tile, both sweeps at once while the tile is in cache
+    void computeTileNetUpdates(solver::Hybrid<float> &tileSolver, int xBegin, int xEnd, int yBegin, int yEnd,
+                               float &maxHorizontalWaveSpeed, float &maxVerticalWaveSpeed);
+
     solver::Hybrid<float> solver;
 
+    // Edge length of the cache tiles in cells, 0 sweeps over the whole block instead
+    int tileSize;
+
     // Temporary values after x-sweep and before y-sweep
-    Float2DNative hStar;
-    Float2DNative huStar;
+    Float2DLayout hStar;
+    Float2DLayout huStar;
 
     // net updates per cell
-    Float2DNative hNetUpdatesLeft;
-    Float2DNative hNetUpdatesRight;
+    Float2DLayout hNetUpdatesLeft;
+    Float2DLayout hNetUpdatesRight;
 
-    Float2DNative huNetUpdatesLeft;
-    Float2DNative huNetUpdatesRight;
+    Float2DLayout huNetUpdatesLeft;
+    Float2DLayout huNetUpdatesRight;
 
-    Float2DNative hNetUpdatesBelow;
-    Float2DNative hNetUpdatesAbove;
+    Float2DLayout hNetUpdatesBelow;
+    Float2DLayout hNetUpdatesAbove;
 
-    Float2DNative hvNetUpdatesBelow;
-    Float2DNative hvNetUpdatesAbove;
+    Float2DLayout hvNetUpdatesBelow;
+    Float2DLayout hvNetUpdatesAbove;
 
     // timer
     std::clock_t computeClock;
@@ -70,8 +70,8 @@ SWE_DimensionalSplittingChameleon::SWE_DimensionalSplittingChameleon (int nx, in
 	SWE_Block(nx, ny, dx, dy, originX, originY, localTimestepping),
     write(write),
 	// intermediate state Q after x-sweep
-	hStar (nx + 1, ny + 2),
-	huStar (nx + 1, ny + 2),
+	hStar (nx + 1, ny + 2, arena),
+	huStar (nx + 1, ny + 2, arena),
 
 	/*
 	 * Temporary storage for the net updates per grid cell during a sweep.
@@ -80,19 +80,39 @@ SWE_DimensionalSplittingChameleon::SWE_DimensionalSplittingChameleon (int nx, in
 	 * Down-going wave from the top edge, analogue for the bottom edge
 	 */
 
+#if defined(ACCUMULATE_NET_UPDATES)
+	// Only the edges of the current column are stored, see computeNumericalFluxes()
+	hNetUpdatesLeft(1, ny + 2, arena),
+	hNetUpdatesRight(1, ny + 2, arena),
+
+	huNetUpdatesLeft(1, ny + 2, arena),
+	huNetUpdatesRight(1, ny + 2, arena),
+
+	hNetUpdatesBelow(1, ny + 2, arena),
+	hNetUpdatesAbove(1, ny + 2, arena),
+
+	hvNetUpdatesBelow(1, ny + 2, arena),
+	hvNetUpdatesAbove(1, ny + 2, arena),
+
+	// Accumulated net updates per cell
+	dh(nx + 2, ny + 2, arena),
+	dhu(nx + 2, ny + 2, arena),
+	dhv(nx + 2, ny + 2, arena) {
+#else
 	// For the x-sweep
-	hNetUpdatesLeft(nx + 2, ny + 2),
-	hNetUpdatesRight(nx + 2, ny + 2),
+	hNetUpdatesLeft(nx + 2, ny + 2, arena),
+	hNetUpdatesRight(nx + 2, ny + 2, arena),
 
-	huNetUpdatesLeft(nx + 2, ny + 2),
-	huNetUpdatesRight(nx + 2, ny + 2),
+	huNetUpdatesLeft(nx + 2, ny + 2, arena),
+	huNetUpdatesRight(nx + 2, ny + 2, arena),
 
 	// For the y-sweep
-	hNetUpdatesBelow(nx + 1, ny + 2),
-	hNetUpdatesAbove(nx + 1, ny + 2),
+	hNetUpdatesBelow(nx + 1, ny + 2, arena),
+	hNetUpdatesAbove(nx + 1, ny + 2, arena),
 
-	hvNetUpdatesBelow(nx + 1, ny + 2),
-	hvNetUpdatesAbove(nx + 1, ny + 2){
+	hvNetUpdatesBelow(nx + 1, ny + 2, arena),
+	hvNetUpdatesAbove(nx + 1, ny + 2, arena){
+#endif // ACCUMULATE_NET_UPDATES
 
 
 		MPI_Type_vector(nx, 1, ny + 2, MPI_FLOAT, &HORIZONTAL_BOUNDARY);
@@ -305,7 +325,7 @@ void SWE_DimensionalSplittingChameleon::setGhostLayer() {
         }
     }
     MPI_Request req;
-    float totalLocalTimestep = getTotalLocalTimestep();
+    TimeScalar totalLocalTimestep = getTotalLocalTimestep();
     if (boundaryType[BND_LEFT] == CONNECT && isSendable(BND_LEFT)) {
         int startIndex = ny + 2 + 1;
 
@@ -318,7 +338,7 @@ void SWE_DimensionalSplittingChameleon::setGhostLayer() {
         MPI_Isend(hv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_OUT_HV_LEFT), MPI_COMM_WORLD, &req);
         MPI_Request_free(&req);
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_TIMESTEP_LEFT), MPI_COMM_WORLD,&req);
+        MPI_Isend(&totalLocalTimestep, 1, MPI_TIME_TYPE, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_TIMESTEP_LEFT), MPI_COMM_WORLD,&req);
         MPI_Request_free(&req);
 
     }
@@ -334,7 +354,7 @@ void SWE_DimensionalSplittingChameleon::setGhostLayer() {
         MPI_Isend(hv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HV_RIGHT), MPI_COMM_WORLD, &req);
         MPI_Request_free(&req);
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_TIMESTEP_RIGHT),MPI_COMM_WORLD, &req);
+        MPI_Isend(&totalLocalTimestep, 1, MPI_TIME_TYPE, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_TIMESTEP_RIGHT),MPI_COMM_WORLD, &req);
         MPI_Request_free(&req);
 
     }
@@ -353,7 +373,7 @@ void SWE_DimensionalSplittingChameleon::setGhostLayer() {
         MPI_Request_free(&req);
         //printf("%d: Sent to bottom %d, %f at %f\n", myRank, neighbourRankId[BND_BOTTOM], h[1][1], originX);
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM], MPI_TAG_TIMESTEP_BOTTOM),MPI_COMM_WORLD, &req);
+        MPI_Isend(&totalLocalTimestep, 1, MPI_TIME_TYPE, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM], MPI_TAG_TIMESTEP_BOTTOM),MPI_COMM_WORLD, &req);
         MPI_Request_free(&req);
 
     }
@@ -369,7 +389,7 @@ void SWE_DimensionalSplittingChameleon::setGhostLayer() {
         MPI_Request_free(&req);
         //printf("%d: Sent to top %d, %f at %f\n", myRank, neighbourRankId[BND_TOP], h[1][ny], originX);
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP], MPI_TAG_TIMESTEP_TOP), MPI_COMM_WORLD,&req);
+        MPI_Isend(&totalLocalTimestep, 1, MPI_TIME_TYPE, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP], MPI_TAG_TIMESTEP_TOP), MPI_COMM_WORLD,&req);
         MPI_Request_free(&req);
 
     }
@@ -416,7 +436,7 @@ void SWE_DimensionalSplittingChameleon::receiveGhostLayer() {
         MPI_Irecv(bufferH.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT],getTag(myRank, MPI_TAG_OUT_H_RIGHT), MPI_COMM_WORLD, &recvReqs[0]);
         MPI_Irecv(bufferHu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT],getTag(myRank, MPI_TAG_OUT_HU_RIGHT), MPI_COMM_WORLD, &recvReqs[1]);
         MPI_Irecv(bufferHv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT],getTag(myRank, MPI_TAG_OUT_HV_RIGHT), MPI_COMM_WORLD, &recvReqs[2]);
-        MPI_Irecv(&borderTimestep[BND_LEFT], 1, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(myRank, MPI_TAG_TIMESTEP_RIGHT), MPI_COMM_WORLD, &recvReqs[3]);
+        MPI_Irecv(&borderTimestep[BND_LEFT], 1, MPI_TIME_TYPE, neighbourLocality[BND_LEFT], getTag(myRank, MPI_TAG_TIMESTEP_RIGHT), MPI_COMM_WORLD, &recvReqs[3]);
 
     } else {
         recvReqs[0] = MPI_REQUEST_NULL;
@@ -431,7 +451,7 @@ void SWE_DimensionalSplittingChameleon::receiveGhostLayer() {
         MPI_Irecv(bufferH.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT],getTag(myRank, MPI_TAG_OUT_H_LEFT), MPI_COMM_WORLD, &recvReqs[4]);
         MPI_Irecv(bufferHu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT],getTag(myRank, MPI_TAG_OUT_HU_LEFT), MPI_COMM_WORLD, &recvReqs[5]);
         MPI_Irecv(bufferHv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT],getTag(myRank, MPI_TAG_OUT_HV_LEFT), MPI_COMM_WORLD, &recvReqs[6]);
-        MPI_Irecv(&borderTimestep[BND_RIGHT], 1, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(myRank, MPI_TAG_TIMESTEP_LEFT), MPI_COMM_WORLD, &recvReqs[7]);
+        MPI_Irecv(&borderTimestep[BND_RIGHT], 1, MPI_TIME_TYPE, neighbourLocality[BND_RIGHT], getTag(myRank, MPI_TAG_TIMESTEP_LEFT), MPI_COMM_WORLD, &recvReqs[7]);
 
     } else {
         recvReqs[4] = MPI_REQUEST_NULL;
@@ -446,7 +466,7 @@ void SWE_DimensionalSplittingChameleon::receiveGhostLayer() {
         MPI_Irecv(&bufferH[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_OUT_H_TOP),MPI_COMM_WORLD, &recvReqs[8]);
         MPI_Irecv(&bufferHu[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_OUT_HU_TOP),MPI_COMM_WORLD, &recvReqs[9]);
         MPI_Irecv(&bufferHv[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_OUT_HV_TOP),MPI_COMM_WORLD, &recvReqs[10]);
-        MPI_Irecv(&borderTimestep[BND_BOTTOM], 1, MPI_FLOAT, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_TIMESTEP_TOP),MPI_COMM_WORLD, &recvReqs[11]);
+        MPI_Irecv(&borderTimestep[BND_BOTTOM], 1, MPI_TIME_TYPE, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_TIMESTEP_TOP),MPI_COMM_WORLD, &recvReqs[11]);
 
     } else {
         recvReqs[8] = MPI_REQUEST_NULL;
@@ -460,7 +480,7 @@ void SWE_DimensionalSplittingChameleon::receiveGhostLayer() {
         MPI_Irecv(&bufferH[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_OUT_H_BOTTOM),MPI_COMM_WORLD, &recvReqs[12]);
         MPI_Irecv(&bufferHu[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_OUT_HU_BOTTOM),MPI_COMM_WORLD, &recvReqs[13]);
         MPI_Irecv(&bufferHv[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_OUT_HV_BOTTOM),MPI_COMM_WORLD, &recvReqs[14]);
-        MPI_Irecv(&borderTimestep[BND_TOP], 1, MPI_FLOAT, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_TIMESTEP_BOTTOM),MPI_COMM_WORLD, &recvReqs[15]);
+        MPI_Irecv(&borderTimestep[BND_TOP], 1, MPI_TIME_TYPE, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_TIMESTEP_BOTTOM),MPI_COMM_WORLD, &recvReqs[15]);
 
     } else {
         recvReqs[12] = MPI_REQUEST_NULL;
@@ -484,7 +504,14 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
                                             float* hNetUpdatesLeft_data, float* hNetUpdatesRight_data,
                                             float* hNetUpdatesBelow_data, float* hNetUpdatesAbove_data,
                                             float* huNetUpdatesLeft_data, float* huNetUpdatesRight_data,
-                                            float* hvNetUpdatesBelow_data, float* hvNetUpdatesAbove_data) {
+                                            float* hvNetUpdatesBelow_data, float* hvNetUpdatesAbove_data
+#if defined(ACCUMULATE_NET_UPDATES)
+                                            , float* dh_data, float* dhu_data, float* dhv_data
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+                                            , float* bDeltaVertical_data, float* bDeltaHorizontal_data
+#endif // BATCHED_SOLVER
+                                            ) {
     // Set data pointers correctly
     block->getModifiableWaterHeight().setRawPointer(h_data);
     block->getModifiableMomentumHorizontal().setRawPointer(hu_data);
@@ -498,6 +525,15 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
     block->huNetUpdatesRight.setRawPointer(huNetUpdatesRight_data);
     block->hvNetUpdatesBelow.setRawPointer(hvNetUpdatesBelow_data);
     block->hvNetUpdatesAbove.setRawPointer(hvNetUpdatesAbove_data);
+#if defined(ACCUMULATE_NET_UPDATES)
+    block->dh.setRawPointer(dh_data);
+    block->dhu.setRawPointer(dhu_data);
+    block->dhv.setRawPointer(dhv_data);
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+    block->edgeBathymetry.vertical.setRawPointer(bDeltaVertical_data);
+    block->edgeBathymetry.horizontal.setRawPointer(bDeltaHorizontal_data);
+#endif // BATCHED_SOLVER
 
 
 #if WAVE_PROPAGATION_SOLVER == 0
@@ -509,6 +545,9 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
     //! Approximate Augmented Riemann solver
     solver::AugRie<float> localSolver = block->solver;
 #endif
+#if defined(BATCHED_SOLVER)
+    solver::HLLEBatch localBatchSolver = block->batchSolver;
+#endif
 
     float maxWaveSpeed = (float) 0.;
 
@@ -517,6 +556,22 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
      **************************************************************************************/
 
     for (int i = 1; i < block->nx+2; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, localBatchSolver.computeNetUpdates (
+                block->ny,
+                block->getWaterHeight()[i - 1] + 1, block->getWaterHeight()[i] + 1,
+                block->getMomentumHorizontal()[i - 1] + 1, block->getMomentumHorizontal()[i] + 1,
+                block->edgeBathymetry.vertical[i - 1],
+                block->hNetUpdatesLeft[edgeColumn], block->hNetUpdatesRight[edgeColumn],
+                block->huNetUpdatesLeft[edgeColumn], block->huNetUpdatesRight[edgeColumn]
+        ));
+#else
         const int ny_end = block->ny+1;
 #if defined(VECTORIZE)
 
@@ -530,14 +585,36 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
                     block->getWaterHeight()[i - 1][j],block->getWaterHeight()[i][j],
                     block->getMomentumHorizontal()[i - 1][j], block->getMomentumHorizontal()[i][j],
                     block->getBathymetry()[i - 1][j], block->getBathymetry()[i][j],
-                    block->hNetUpdatesLeft[i - 1][j - 1], block->hNetUpdatesRight[i - 1][j - 1],
-                    block->huNetUpdatesLeft[i - 1][j - 1], block->huNetUpdatesRight[i - 1][j - 1],
+                    block->hNetUpdatesLeft[edgeColumn][j - 1], block->hNetUpdatesRight[edgeColumn][j - 1],
+                    block->huNetUpdatesLeft[edgeColumn][j - 1], block->huNetUpdatesRight[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
 
             //update the thread-local maximum wave speed
             maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // The edges complete cell i - 1 and are the first contribution to cell i
+        if (i > 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < block->ny + 1; j++) {
+                block->dh[i - 1][j] += block->hNetUpdatesLeft[0][j - 1] / block->dx;
+                block->dhu[i - 1][j] += block->huNetUpdatesLeft[0][j - 1] / block->dx;
+            }
+        }
+        if (i < block->nx + 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < block->ny + 1; j++) {
+                block->dh[i][j] = block->hNetUpdatesRight[0][j - 1] / block->dx;
+                block->dhu[i][j] = block->huNetUpdatesRight[0][j - 1] / block->dx;
+            }
+        }
+#endif // ACCUMULATE_NET_UPDATES
     }
 
     /***************************************************************************************
@@ -545,6 +622,22 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
      **************************************************************************************/
 
     for (int i=1; i < block->nx + 1; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, localBatchSolver.computeNetUpdates (
+                block->ny + 1,
+                block->getWaterHeight()[i], block->getWaterHeight()[i] + 1,
+                block->getMomentumVertical()[i], block->getMomentumVertical()[i] + 1,
+                block->edgeBathymetry.horizontal[i - 1],
+                block->hNetUpdatesBelow[edgeColumn], block->hNetUpdatesAbove[edgeColumn],
+                block->hvNetUpdatesBelow[edgeColumn], block->hvNetUpdatesAbove[edgeColumn]
+        ));
+#else
         const int ny_end = block->ny+2;
 #if defined(VECTORIZE)
 
@@ -558,14 +651,25 @@ void computeNumericalFluxesKernel(SWE_DimensionalSplittingChameleon* block, floa
                     block->getWaterHeight()[i][j - 1],  block->getWaterHeight()[i][j],
                     block->getMomentumVertical()[i][j - 1], block->getMomentumVertical()[i][j],
                     block->getBathymetry()[i][j - 1], block->getBathymetry()[i][j],
-                    block->hNetUpdatesBelow[i - 1][j - 1], block->hNetUpdatesAbove[i - 1][j - 1],
-                    block->hvNetUpdatesBelow[i - 1][j - 1], block->hvNetUpdatesAbove[i - 1][j - 1],
+                    block->hNetUpdatesBelow[edgeColumn][j - 1], block->hNetUpdatesAbove[edgeColumn][j - 1],
+                    block->hvNetUpdatesBelow[edgeColumn][j - 1], block->hvNetUpdatesAbove[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
 
             //update the maximum wave speed
             maxWaveSpeed = std::max (maxWaveSpeed, maxEdgeSpeed);
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Add the contributions of the edges below and above cell (i, j)
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < block->ny + 1; j++) {
+            block->dh[i][j] += (block->hNetUpdatesAbove[0][j - 1] + block->hNetUpdatesBelow[0][j]) / block->dy;
+            block->dhv[i][j] = (block->hvNetUpdatesAbove[0][j - 1] + block->hvNetUpdatesBelow[0][j]) / block->dy;
+        }
+#endif // ACCUMULATE_NET_UPDATES
     }
 
     if (maxWaveSpeed > 0.00001) {
@@ -584,8 +688,30 @@ void SWE_DimensionalSplittingChameleon::computeNumericalFluxes() {
 
     if (!allGhostlayersInSync()) return;
     collector.addFlops(2*135*nx*ny);
-
-    chameleon_map_data_entry_t* args = new chameleon_map_data_entry_t[14];
+#if defined(BATCHED_SOLVER)
+    // The bathymetry is static once it has been exchanged, so the edge differences are computed on first use
+    if (!edgeBathymetry.isInitialized()) {
+        edgeBathymetry = EdgeBathymetry(nx, ny);
+        edgeBathymetry.compute(b);
+    }
+#endif // BATCHED_SOLVER
+
+#if defined(ACCUMULATE_NET_UPDATES)
+    // Only one column of edges is stored, the updates are accumulated in dh, dhu and dhv
+    const int xSweepColumns = 1;
+    const int ySweepColumns = 1;
+    int argCount = 17;
+#else
+    const int xSweepColumns = nx + 2;
+    const int ySweepColumns = nx + 1;
+    int argCount = 14;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+    // The edge bathymetry differences are passed as the last two arguments
+    argCount += 2;
+#endif // BATCHED_SOLVER
+
+    chameleon_map_data_entry_t* args = new chameleon_map_data_entry_t[argCount];
     args[0] = chameleon_map_data_entry_create(this, sizeof(SWE_DimensionalSplittingChameleon), CHAM_OMP_TGT_MAPTYPE_TO);
     args[1] = chameleon_map_data_entry_create(&(this->maxTimestep), sizeof(float), CHAM_OMP_TGT_MAPTYPE_FROM);
     args[2] = chameleon_map_data_entry_create(this->getWaterHeight().getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_TO);
@@ -593,20 +719,29 @@ void SWE_DimensionalSplittingChameleon::computeNumericalFluxes() {
     args[4] = chameleon_map_data_entry_create(this->hv.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_TO);
     args[5] = chameleon_map_data_entry_create(this->b.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_TO);
 
-    args[6] = chameleon_map_data_entry_create(this->hNetUpdatesLeft.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-    args[7] = chameleon_map_data_entry_create(this->hNetUpdatesRight.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-    args[8] = chameleon_map_data_entry_create(this->hNetUpdatesBelow.getRawPointer(), sizeof(float)*(nx + 1)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-    args[9] = chameleon_map_data_entry_create(this->hNetUpdatesAbove.getRawPointer(), sizeof(float)*(nx + 1)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-
-    args[10] = chameleon_map_data_entry_create(this->huNetUpdatesLeft.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-    args[11] = chameleon_map_data_entry_create(this->huNetUpdatesRight.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-
-    args[12] = chameleon_map_data_entry_create(this->hvNetUpdatesBelow.getRawPointer(), sizeof(float)*(nx + 1)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
-    args[13] = chameleon_map_data_entry_create(this->hvNetUpdatesAbove.getRawPointer(), sizeof(float)*(nx + 1)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[6] = chameleon_map_data_entry_create(this->hNetUpdatesLeft.getRawPointer(), sizeof(float)*xSweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[7] = chameleon_map_data_entry_create(this->hNetUpdatesRight.getRawPointer(), sizeof(float)*xSweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[8] = chameleon_map_data_entry_create(this->hNetUpdatesBelow.getRawPointer(), sizeof(float)*ySweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[9] = chameleon_map_data_entry_create(this->hNetUpdatesAbove.getRawPointer(), sizeof(float)*ySweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+
+    args[10] = chameleon_map_data_entry_create(this->huNetUpdatesLeft.getRawPointer(), sizeof(float)*xSweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[11] = chameleon_map_data_entry_create(this->huNetUpdatesRight.getRawPointer(), sizeof(float)*xSweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+
+    args[12] = chameleon_map_data_entry_create(this->hvNetUpdatesBelow.getRawPointer(), sizeof(float)*ySweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[13] = chameleon_map_data_entry_create(this->hvNetUpdatesAbove.getRawPointer(), sizeof(float)*ySweepColumns*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+#if defined(ACCUMULATE_NET_UPDATES)
+    args[14] = chameleon_map_data_entry_create(this->dh.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[15] = chameleon_map_data_entry_create(this->dhu.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+    args[16] = chameleon_map_data_entry_create(this->dhv.getRawPointer(), sizeof(float)*(nx + 2)*(ny + 2), CHAM_OMP_TGT_MAPTYPE_FROM);
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+    args[argCount - 2] = chameleon_map_data_entry_create(edgeBathymetry.vertical.getRawPointer(), sizeof(float)*(nx + 1)*ny, CHAM_OMP_TGT_MAPTYPE_TO);
+    args[argCount - 1] = chameleon_map_data_entry_create(edgeBathymetry.horizontal.getRawPointer(), sizeof(float)*nx*(ny + 1), CHAM_OMP_TGT_MAPTYPE_TO);
+#endif // BATCHED_SOLVER
 
     cham_migratable_task_t *cur_task = chameleon_create_task(
             (void *)&computeNumericalFluxesKernel,
-            14, // number of args
+            argCount, // number of args
             args);
     int32_t res = chameleon_add_task(cur_task);
 }
@@ -694,9 +829,15 @@ void SWE_DimensionalSplittingChameleon::updateUnknowns (float dt) {
 #pragma omp simd
 #endif // VECTORIZE
         for (int j = 1; j < ny_end; j++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+            h[i][j] -= dt * dh[i][j];
+            hu[i][j] -= dt * dhu[i][j];
+            hv[i][j] -= dt * dhv[i][j];
+#else
             h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
             hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
             hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
+#endif // ACCUMULATE_NET_UPDATES
 
             if (h[i][j] < 0) {
                 //TODO: dryTol
@@ -47,6 +47,11 @@
 #elif WAVE_PROPAGATION_SOLVER==2
 #include "solvers/AugRie.hpp"
 #endif
+
+#if defined(BATCHED_SOLVER)
+#include "tools/HLLEBatch.hh"
+#include "tools/EdgeBathymetry.hh"
+#endif
 class SWE_DimensionalSplittingChameleon : public SWE_Block<Float2DNative> {
 	public:
 		// Constructor/Destructor
@@ -92,6 +97,13 @@ class SWE_DimensionalSplittingChameleon : public SWE_Block<Float2DNative> {
     solver::AugRie<float> solver;
 #endif
 
+#if defined(BATCHED_SOLVER)
+    //! Explicitly vectorized HLLE solver, used for whole columns of edges
+    solver::HLLEBatch batchSolver;
+    //! Bathymetry differences of all edges, computed once
+    EdgeBathymetry edgeBathymetry;
+#endif
+
     // Temporary values after x-sweep and before y-sweep
 		Float2DNative hStar;
 		Float2DNative huStar;
@@ -109,6 +121,14 @@ class SWE_DimensionalSplittingChameleon : public SWE_Block<Float2DNative> {
 		Float2DNative hvNetUpdatesBelow;
 		Float2DNative hvNetUpdatesAbove;
 
+#if defined(ACCUMULATE_NET_UPDATES)
+		// Net updates accumulated per cell and scaled by the cell size,
+		// the edge arrays above then only hold the edges of the current column
+		Float2DNative dh;
+		Float2DNative dhu;
+		Float2DNative dhv;
+#endif
+
 
 
 
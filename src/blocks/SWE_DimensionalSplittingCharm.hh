@@ -33,6 +33,11 @@
 #include "solvers/AugRie.hpp"
 #endif
 
+#if defined(BATCHED_SOLVER)
+#include "tools/HLLEBatch.hh"
+#include "tools/EdgeBathymetry.hh"
+#endif
+
 extern CProxy_swe_charm mainProxy;
 extern int blockCountX;
 extern int blockCountY;
@@ -112,28 +117,51 @@ public:
 
 
             checkpointInstantOfTime = new float[checkpointCount];
-            // For the x-sweep
-            hNetUpdatesLeft = Float2DNative(nx + 2, ny + 2);
-            hNetUpdatesRight = Float2DNative(nx + 2, ny + 2);
 
-            huNetUpdatesLeft = Float2DNative(nx + 2, ny + 2);
-            huNetUpdatesRight = Float2DNative(nx + 2, ny + 2);
+            // Same allocation order as the constructor, so the arrays are at the same offsets of the arena
+            arena = tools::BlockArena(nx + 2, ny + 2);
 
-            // For the y-sweep
-            hNetUpdatesBelow = Float2DNative(nx + 1, ny + 2);
-            hNetUpdatesAbove = Float2DNative(nx + 1, ny + 2);
+            h  = Float2DNative(nx + 2, ny + 2, arena);
+            hu = Float2DNative(nx + 2, ny + 2, arena);
+            hv = Float2DNative(nx + 2, ny + 2, arena);
+            b  = Float2DNative(nx + 2, ny + 2, arena);
+
+            bufferH = Float2DBuffer(nx + 2, ny + 2, localTimestepping, h, arena);
+            bufferHu = Float2DBuffer(nx + 2, ny + 2, localTimestepping, hu, arena);
+            bufferHv = Float2DBuffer(nx + 2, ny + 2, localTimestepping, hv, arena);
 
-            hvNetUpdatesBelow = Float2DNative(nx + 1, ny + 2);
-            hvNetUpdatesAbove = Float2DNative (nx + 1, ny + 2);
+#if defined(ACCUMULATE_NET_UPDATES)
+            // Only the edges of the current column are stored
+            hNetUpdatesLeft = Float2DNative(1, ny + 2, arena);
+            hNetUpdatesRight = Float2DNative(1, ny + 2, arena);
 
-            h  = Float2DNative(nx + 2, ny + 2);
-            hu = Float2DNative(nx + 2, ny + 2);
-            hv = Float2DNative(nx + 2, ny + 2);
-            b  = Float2DNative(nx + 2, ny + 2);
+            huNetUpdatesLeft = Float2DNative(1, ny + 2, arena);
+            huNetUpdatesRight = Float2DNative(1, ny + 2, arena);
+
+            hNetUpdatesBelow = Float2DNative(1, ny + 2, arena);
+            hNetUpdatesAbove = Float2DNative(1, ny + 2, arena);
+
+            hvNetUpdatesBelow = Float2DNative(1, ny + 2, arena);
+            hvNetUpdatesAbove = Float2DNative(1, ny + 2, arena);
+
+            dh = Float2DNative(nx + 2, ny + 2, arena);
+            dhu = Float2DNative(nx + 2, ny + 2, arena);
+            dhv = Float2DNative(nx + 2, ny + 2, arena);
+#else
+            // For the x-sweep
+            hNetUpdatesLeft = Float2DNative(nx + 2, ny + 2, arena);
+            hNetUpdatesRight = Float2DNative(nx + 2, ny + 2, arena);
 
-            bufferH = Float2DBuffer(nx + 2, ny + 2, localTimestepping, h);
-            bufferHu = Float2DBuffer(nx + 2, ny + 2, localTimestepping, hu);
-            bufferHv = Float2DBuffer(nx + 2, ny + 2, localTimestepping, hv);
+            huNetUpdatesLeft = Float2DNative(nx + 2, ny + 2, arena);
+            huNetUpdatesRight = Float2DNative(nx + 2, ny + 2, arena);
+
+            // For the y-sweep
+            hNetUpdatesBelow = Float2DNative(nx + 1, ny + 2, arena);
+            hNetUpdatesAbove = Float2DNative(nx + 1, ny + 2, arena);
+
+            hvNetUpdatesBelow = Float2DNative(nx + 1, ny + 2, arena);
+            hvNetUpdatesAbove = Float2DNative (nx + 1, ny + 2, arena);
+#endif // ACCUMULATE_NET_UPDATES
 
             //writer = (NetCdfWriter*) malloc(sizeof(NetCdfWriter));
             collector = new CollectorCharm();
@@ -162,6 +190,13 @@ public:
 
         PUParray(p, checkpointInstantOfTime,checkpointCount );
 
+#if defined(BLOCK_ARENA)
+        // h, hu, hv, b and the buffers are the first arrays of the arena, they are migrated with a single copy
+        float *lastArray = localTimestepping ? bufferHv.getRawPointer() : b.getRawPointer();
+        char *stateBegin = (char *) h.getRawPointer();
+        char *stateEnd = (char *) (lastArray + (nx + 2) * b.getStride());
+        PUParray(p, stateBegin, stateEnd - stateBegin);
+#else
         int size = (nx+2)*(ny+2);
         PUParray(p, h.getRawPointer(),size );
         PUParray(p, hu.getRawPointer(),size );
@@ -173,6 +208,7 @@ public:
             PUParray(p, bufferHu.getRawPointer(),size );
             PUParray(p, bufferHv.getRawPointer(),size );
         }
+#endif
 
     }
 
@@ -203,11 +239,18 @@ private:
     //! Approximate Augmented Riemann solver
     solver::AugRie<float> solver;
 #endif
+
+#if defined(BATCHED_SOLVER)
+    //! Explicitly vectorized HLLE solver, used for whole columns of edges
+    solver::HLLEBatch batchSolver;
+    //! Bathymetry differences of all edges, computed once
+    EdgeBathymetry edgeBathymetry;
+#endif
     double collectorSerializer[9];
     float *checkpointInstantOfTime;
     bool write;
     NetCdfWriter *writer;
-    float currentSimulationTime;
+    TimeScalar currentSimulationTime;
     int currentCheckpoint;
     int receiveCounter = 0;
     int migrated = 0;
@@ -229,6 +272,14 @@ private:
 
     Float2DNative hvNetUpdatesBelow;
     Float2DNative hvNetUpdatesAbove;
+
+#if defined(ACCUMULATE_NET_UPDATES)
+    // Net updates accumulated per cell and scaled by the cell size,
+    // the edge arrays above then only hold the edges of the current column
+    Float2DNative dh;
+    Float2DNative dhu;
+    Float2DNative dhv;
+#endif
     std::string outputFilename;
     // Interfaces to neighbouring block copy layers, indexed by Boundary
     int neighbourIndex[4];
@@ -248,7 +299,7 @@ public:
     float *h;
     float *hu;
     float *hv;
-    float timestep;
+    TimeScalar timestep;
 };
 
 class collectorMsg : public CMessage_collectorMsg {
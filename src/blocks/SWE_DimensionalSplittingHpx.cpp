@@ -72,8 +72,8 @@ SWE_DimensionalSplittingHpx::SWE_DimensionalSplittingHpx(int nx, int ny, float d
         SWE_Block(nx, ny, dx, dy, originX, originY, localTimestepping),
 
         // intermediate state Q after x-sweep
-        hStar(nx + 1, ny + 2),
-        huStar(nx + 1, ny + 2),
+        hStar(nx + 1, ny + 2, arena),
+        huStar(nx + 1, ny + 2, arena),
 
         /*
          * Temporary storage for the net updates per grid cell during a sweep.
@@ -82,19 +82,39 @@ SWE_DimensionalSplittingHpx::SWE_DimensionalSplittingHpx(int nx, int ny, float d
          * Down-going wave from the top edge, analogue for the bottom edge
          */
 
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the edges of the current column are stored, see computeNumericalFluxes()
+        hNetUpdatesLeft(1, ny + 2, arena),
+        hNetUpdatesRight(1, ny + 2, arena),
+
+        huNetUpdatesLeft(1, ny + 2, arena),
+        huNetUpdatesRight(1, ny + 2, arena),
+
+        hNetUpdatesBelow(1, ny + 2, arena),
+        hNetUpdatesAbove(1, ny + 2, arena),
+
+        hvNetUpdatesBelow(1, ny + 2, arena),
+        hvNetUpdatesAbove(1, ny + 2, arena),
+
+        // Accumulated net updates per cell
+        dh(nx + 2, ny + 2, arena),
+        dhu(nx + 2, ny + 2, arena),
+        dhv(nx + 2, ny + 2, arena) {
+#else
         // For the x-sweep
-        hNetUpdatesLeft(nx + 2, ny + 2),
-        hNetUpdatesRight(nx + 2, ny + 2),
+        hNetUpdatesLeft(nx + 2, ny + 2, arena),
+        hNetUpdatesRight(nx + 2, ny + 2, arena),
 
-        huNetUpdatesLeft(nx + 2, ny + 2),
-        huNetUpdatesRight(nx + 2, ny + 2),
+        huNetUpdatesLeft(nx + 2, ny + 2, arena),
+        huNetUpdatesRight(nx + 2, ny + 2, arena),
 
         // For the y-sweep
-        hNetUpdatesBelow(nx + 1, ny + 2),
-        hNetUpdatesAbove(nx + 1, ny + 2),
+        hNetUpdatesBelow(nx + 1, ny + 2, arena),
+        hNetUpdatesAbove(nx + 1, ny + 2, arena),
 
-        hvNetUpdatesBelow(nx + 1, ny + 2),
-        hvNetUpdatesAbove(nx + 1, ny + 2) {
+        hvNetUpdatesBelow(nx + 1, ny + 2, arena),
+        hvNetUpdatesAbove(nx + 1, ny + 2, arena) {
+#endif // ACCUMULATE_NET_UPDATES
     if (write) {
         writer = new NetCdfWriter(
                 name,
@@ -319,6 +339,13 @@ hpx::future<void> SWE_DimensionalSplittingHpx::setGhostLayer() {
 
 void SWE_DimensionalSplittingHpx::computeNumericalFluxes() {
     if (!allGhostlayersInSync()) return;
+#if defined(BATCHED_SOLVER)
+    // The bathymetry is static once it has been exchanged, so the edge differences are computed on first use
+    if (!edgeBathymetry.isInitialized()) {
+        edgeBathymetry = EdgeBathymetry(nx, ny);
+        edgeBathymetry.compute(b);
+    }
+#endif // BATCHED_SOLVER
 
 //maximum (linearized) wave speed within one iteration
     float maxWaveSpeed = (float) 0.;
@@ -328,6 +355,22 @@ void SWE_DimensionalSplittingHpx::computeNumericalFluxes() {
      **************************************************************************************/
 
     for (int i = 1; i < nx+2; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny,
+                h[i - 1] + 1, h[i] + 1,
+                hu[i - 1] + 1, hu[i] + 1,
+                edgeBathymetry.vertical[i - 1],
+                hNetUpdatesLeft[edgeColumn], hNetUpdatesRight[edgeColumn],
+                huNetUpdatesLeft[edgeColumn], huNetUpdatesRight[edgeColumn]
+        ));
+#else
         const int ny_end = ny+1;
 
 #if defined(VECTORIZE)
@@ -342,12 +385,34 @@ void SWE_DimensionalSplittingHpx::computeNumericalFluxes() {
                     h[i - 1][j], h[i][j],
                     hu[i - 1][j], hu[i][j],
                     b[i - 1][j], b[i][j],
-                    hNetUpdatesLeft[i - 1][j - 1], hNetUpdatesRight[i - 1][j - 1],
-                    huNetUpdatesLeft[i - 1][j - 1], huNetUpdatesRight[i - 1][j - 1],
+                    hNetUpdatesLeft[edgeColumn][j - 1], hNetUpdatesRight[edgeColumn][j - 1],
+                    huNetUpdatesLeft[edgeColumn][j - 1], huNetUpdatesRight[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
             maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // The edges complete cell i - 1 and are the first contribution to cell i
+        if (i > 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i - 1][j] += hNetUpdatesLeft[0][j - 1] / dx;
+                dhu[i - 1][j] += huNetUpdatesLeft[0][j - 1] / dx;
+            }
+        }
+        if (i < nx + 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i][j] = hNetUpdatesRight[0][j - 1] / dx;
+                dhu[i][j] = huNetUpdatesRight[0][j - 1] / dx;
+            }
+        }
+#endif // ACCUMULATE_NET_UPDATES
 
     }
 /*
@@ -417,6 +482,22 @@ void SWE_DimensionalSplittingHpx::computeNumericalFluxes() {
 */
 
     for (int i=1; i < nx + 1; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny + 1,
+                h[i], h[i] + 1,
+                hv[i], hv[i] + 1,
+                edgeBathymetry.horizontal[i - 1],
+                hNetUpdatesBelow[edgeColumn], hNetUpdatesAbove[edgeColumn],
+                hvNetUpdatesBelow[edgeColumn], hvNetUpdatesAbove[edgeColumn]
+        ));
+#else
         const int ny_end = ny+2;
 
 #if defined(VECTORIZE)
@@ -430,8 +511,8 @@ void SWE_DimensionalSplittingHpx::computeNumericalFluxes() {
                     h[i][j - 1], h[i][j],
                     hv[i][j - 1], hv[i][j],
                     b[i][j - 1], b[i][j],
-                    hNetUpdatesBelow[i - 1][j - 1], hNetUpdatesAbove[i - 1][j - 1],
-                    hvNetUpdatesBelow[i - 1][j - 1], hvNetUpdatesAbove[i - 1][j - 1],
+                    hNetUpdatesBelow[edgeColumn][j - 1], hNetUpdatesAbove[edgeColumn][j - 1],
+                    hvNetUpdatesBelow[edgeColumn][j - 1], hvNetUpdatesAbove[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
 
@@ -440,6 +521,17 @@ void SWE_DimensionalSplittingHpx::computeNumericalFluxes() {
            //maxTestSpeed = std::max (maxTestSpeed, maxEdgeSpeed);
 
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Add the contributions of the edges below and above cell (i, j)
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny + 1; j++) {
+            dh[i][j] += (hNetUpdatesAbove[0][j - 1] + hNetUpdatesBelow[0][j]) / dy;
+            dhv[i][j] = (hvNetUpdatesAbove[0][j - 1] + hvNetUpdatesBelow[0][j]) / dy;
+        }
+#endif // ACCUMULATE_NET_UPDATES
     }
 
     if (maxWaveSpeed > 0.00001) {
@@ -485,9 +577,15 @@ void SWE_DimensionalSplittingHpx::updateUnknowns(float dt) {
  #endif // VECTORIZE
 
          for (int j = 1; j < ny_end; j++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+             h[i][j] -= dt * dh[i][j];
+             hu[i][j] -= dt * dhu[i][j];
+             hv[i][j] -= dt * dhv[i][j];
+#else
              h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
              hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
              hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
+#endif // ACCUMULATE_NET_UPDATES
 
              if (h[i][j] < 0) {
                  //TODO: dryTol
@@ -25,6 +25,11 @@
 #include "solvers/AugRie.hpp"
 #endif
 
+#if defined(BATCHED_SOLVER)
+#include "tools/HLLEBatch.hh"
+#include "tools/EdgeBathymetry.hh"
+#endif
+
 #include "writer/NetCdfWriter.hh"
 #include <hpx/include/compute.hpp>
 #include <hpx/include/lcos.hpp>
@@ -44,7 +49,7 @@ struct copyLayerStruct {
     T H;
     T Hu;
     T Hv;
-    float timestep = 0;
+    TimeScalar timestep = 0;
 
     template<typename Archive>
     void serialize(Archive &ar, unsigned) {
@@ -89,7 +94,7 @@ public:
     NetCdfWriter *writer;
     float maxTimestepGlobal;
     float checkTimestep;
-    float currentTotalLocalTimestep; //used to not have raceconditions in local copying
+    TimeScalar currentTotalLocalTimestep; //used to not have raceconditions in local copying
     void writeTimestep(float timestep);
 
 private:
@@ -105,6 +110,13 @@ private:
     solver::AugRie<float> solver;
 #endif
 
+#if defined(BATCHED_SOLVER)
+    //! Explicitly vectorized HLLE solver, used for whole columns of edges
+    solver::HLLEBatch batchSolver;
+    //! Bathymetry differences of all edges, computed once
+    EdgeBathymetry edgeBathymetry;
+#endif
+
     communicator_type comm;
     // Max timestep reduced over all upcxx ranks
 
@@ -125,6 +137,14 @@ private:
     Float2DNative hvNetUpdatesBelow;
     Float2DNative hvNetUpdatesAbove;
 
+#if defined(ACCUMULATE_NET_UPDATES)
+    // Net updates accumulated per cell and scaled by the cell size,
+    // the edge arrays above then only hold the edges of the current column
+    Float2DNative dh;
+    Float2DNative dhu;
+    Float2DNative dhv;
+#endif
+
     /* Copy buffer:
      * Since Float2D are stored column-wise in memory,
      * it is expensive to read rows from a Float2D since it is necessary to stride an entire column after each read element.
@@ -68,8 +68,8 @@ SWE_DimensionalSplittingMPIOverdecomp::SWE_DimensionalSplittingMPIOverdecomp (in
 	SWE_Block(nx, ny, dx, dy, originX, originY, localTimestepping),
     write(write),
 	// intermediate state Q after x-sweep
-	hStar (nx + 1, ny + 2),
-	huStar (nx + 1, ny + 2),
+	hStar (nx + 1, ny + 2, arena),
+	huStar (nx + 1, ny + 2, arena),
 
 	/*
 	 * Temporary storage for the net updates per grid cell during a sweep.
@@ -78,23 +78,55 @@ SWE_DimensionalSplittingMPIOverdecomp::SWE_DimensionalSplittingMPIOverdecomp (in
 	 * Down-going wave from the top edge, analogue for the bottom edge
 	 */
 
+#if defined(ACCUMULATE_NET_UPDATES)
+	// Only the edges of the current column are stored, see computeNumericalFluxes()
+	hNetUpdatesLeft(1, ny + 2, arena),
+	hNetUpdatesRight(1, ny + 2, arena),
+
+	huNetUpdatesLeft(1, ny + 2, arena),
+	huNetUpdatesRight(1, ny + 2, arena),
+
+	hNetUpdatesBelow(1, ny + 2, arena),
+	hNetUpdatesAbove(1, ny + 2, arena),
+
+	hvNetUpdatesBelow(1, ny + 2, arena),
+	hvNetUpdatesAbove(1, ny + 2, arena),
+
+	// Accumulated net updates per cell
+	dh(nx + 2, ny + 2, arena),
+	dhu(nx + 2, ny + 2, arena),
+	dhv(nx + 2, ny + 2, arena) {
+#else
 	// For the x-sweep
-	hNetUpdatesLeft(nx + 2, ny + 2),
-	hNetUpdatesRight(nx + 2, ny + 2),
+	hNetUpdatesLeft(nx + 2, ny + 2, arena),
+	hNetUpdatesRight(nx + 2, ny + 2, arena),
 
-	huNetUpdatesLeft(nx + 2, ny + 2),
-	huNetUpdatesRight(nx + 2, ny + 2),
+	huNetUpdatesLeft(nx + 2, ny + 2, arena),
+	huNetUpdatesRight(nx + 2, ny + 2, arena),
 
 	// For the y-sweep
-	hNetUpdatesBelow(nx + 1, ny + 2),
-	hNetUpdatesAbove(nx + 1, ny + 2),
+	hNetUpdatesBelow(nx + 1, ny + 2, arena),
+	hNetUpdatesAbove(nx + 1, ny + 2, arena),
 
-	hvNetUpdatesBelow(nx + 1, ny + 2),
-	hvNetUpdatesAbove(nx + 1, ny + 2){
+	hvNetUpdatesBelow(nx + 1, ny + 2, arena),
+	hvNetUpdatesAbove(nx + 1, ny + 2, arena){
+#endif // ACCUMULATE_NET_UPDATES
 
 
 		MPI_Type_vector(nx, 1, ny + 2, MPI_FLOAT, &HORIZONTAL_BOUNDARY);
 		MPI_Type_commit(&HORIZONTAL_BOUNDARY);
+#if defined(DRY_TILE_SKIPPING)
+    tileActivity = TileActivity(nx, ny, tileSize);
+#endif
+#if defined(WAVEFRONT_TRACKING)
+    wavefrontBox = WavefrontBox(nx, ny);
+#endif
+#if defined(SHARED_EDGE_COLUMNS)
+    hColumnLeft = h[0];
+    huColumnLeft = hu[0];
+    hColumnRight = h[nx + 1];
+    huColumnRight = hu[nx + 1];
+#endif
     if(write){
         writer = new NetCdfWriter(
                 name,
@@ -136,6 +168,24 @@ void SWE_DimensionalSplittingMPIOverdecomp::connectLocalNeighbours(std::array<st
         }
 
     }
+#if defined(SHARED_EDGE_COLUMNS)
+    // With global timestepping, the ghost column of an on-rank neighbour always equals its edge column
+    // while the fluxes are computed, so the x-sweep reads that column instead of a copy.
+    // The rows at the lower and upper border are strided in both blocks, they are still copied.
+    // With local timestepping, the ghost layer may lag behind or be interpolated.
+    if (!localTimestepping) {
+        if (boundaryType[BND_LEFT] == CONNECT_WITHIN_RANK) {
+            hColumnLeft = left->getWaterHeight()[left->nx];
+            huColumnLeft = left->getMomentumHorizontal()[left->nx];
+            sharedEdgeColumn[BND_LEFT] = true;
+        }
+        if (boundaryType[BND_RIGHT] == CONNECT_WITHIN_RANK) {
+            hColumnRight = right->getWaterHeight()[1];
+            huColumnRight = right->getMomentumHorizontal()[1];
+            sharedEdgeColumn[BND_RIGHT] = true;
+        }
+    }
+#endif // SHARED_EDGE_COLUMNS
 }
 
 void SWE_DimensionalSplittingMPIOverdecomp::connectNeighbourLocalities(int p_neighbourRankId[]) {
@@ -146,9 +196,6 @@ void SWE_DimensionalSplittingMPIOverdecomp::connectNeighbourLocalities(int p_nei
 
 
 
-void SWE_DimensionalSplittingMPIOverdecomp::freeMpiType() {
-	MPI_Type_free(&HORIZONTAL_BOUNDARY);
-}
 int getTag(int rank, int tag){
    // return (tag*100000) + rank;
    //max tag is 32767
@@ -156,6 +203,71 @@ int getTag(int rank, int tag){
     return (tag*6553 )+ (rank%511);
 }
 
+/**
+ * Creates the persistent requests of the ghost layer exchange.
+ * Has to be called after initScenario(), connectNeighbourLocalities() and setRank(),
+ * the tags depend on the rank ids of this block and its neighbours.
+ */
+void SWE_DimensionalSplittingMPIOverdecomp::connectNeighbours(int p_neighbourRankId[]) {
+    SWE_Block<Float2DNative>::connectNeighbours(p_neighbourRankId);
+
+    // Tags of h, hu, hv and the timestep sent to / received from the neighbour at each boundary
+    const int sendTags[4][4] = {
+            {MPI_TAG_OUT_H_LEFT, MPI_TAG_OUT_HU_LEFT, MPI_TAG_OUT_HV_LEFT, MPI_TAG_TIMESTEP_LEFT},
+            {MPI_TAG_OUT_H_RIGHT, MPI_TAG_OUT_HU_RIGHT, MPI_TAG_OUT_HV_RIGHT, MPI_TAG_TIMESTEP_RIGHT},
+            {MPI_TAG_OUT_H_BOTTOM, MPI_TAG_OUT_HU_BOTTOM, MPI_TAG_OUT_HV_BOTTOM, MPI_TAG_TIMESTEP_BOTTOM},
+            {MPI_TAG_OUT_H_TOP, MPI_TAG_OUT_HU_TOP, MPI_TAG_OUT_HV_TOP, MPI_TAG_TIMESTEP_TOP}};
+    const int receiveTags[4][4] = {
+            {MPI_TAG_OUT_H_RIGHT, MPI_TAG_OUT_HU_RIGHT, MPI_TAG_OUT_HV_RIGHT, MPI_TAG_TIMESTEP_RIGHT},
+            {MPI_TAG_OUT_H_LEFT, MPI_TAG_OUT_HU_LEFT, MPI_TAG_OUT_HV_LEFT, MPI_TAG_TIMESTEP_LEFT},
+            {MPI_TAG_OUT_H_TOP, MPI_TAG_OUT_HU_TOP, MPI_TAG_OUT_HV_TOP, MPI_TAG_TIMESTEP_TOP},
+            {MPI_TAG_OUT_H_BOTTOM, MPI_TAG_OUT_HU_BOTTOM, MPI_TAG_OUT_HV_BOTTOM, MPI_TAG_TIMESTEP_BOTTOM}};
+
+    // First sent and received cell of each boundary
+    const int sendCol[4] = {1, nx, 1, 1};
+    const int sendRow[4] = {1, 1, 1, ny};
+    const int receiveCol[4] = {0, nx + 1, 1, 1};
+    const int receiveRow[4] = {1, 1, 0, ny + 1};
+
+    for (int border = 0; border < 4; border++) {
+        MPI_Request *send = &sendRequests[4 * border];
+        MPI_Request *receive = &receiveRequests[4 * border];
+        if (boundaryType[border] != CONNECT) {
+            for (int k = 0; k < 4; k++)
+                send[k] = receive[k] = MPI_REQUEST_NULL;
+            continue;
+        }
+
+        // Columns are contiguous, rows are sent with the strided type
+        const bool row = border == BND_BOTTOM || border == BND_TOP;
+        const int count = row ? 1 : ny;
+        const MPI_Datatype type = row ? HORIZONTAL_BOUNDARY : MPI_FLOAT;
+        const int locality = neighbourLocality[border];
+        const int i = sendCol[border], j = sendRow[border];
+        const int k = receiveCol[border], l = receiveRow[border];
+
+        MPI_Send_init(&h[i][j], count, type, locality, getTag(neighbourRankId[border], sendTags[border][0]), MPI_COMM_WORLD, &send[0]);
+        MPI_Send_init(&hu[i][j], count, type, locality, getTag(neighbourRankId[border], sendTags[border][1]), MPI_COMM_WORLD, &send[1]);
+        MPI_Send_init(&hv[i][j], count, type, locality, getTag(neighbourRankId[border], sendTags[border][2]), MPI_COMM_WORLD, &send[2]);
+        MPI_Send_init(&sentTimestep, 1, MPI_TIME_TYPE, locality, getTag(neighbourRankId[border], sendTags[border][3]), MPI_COMM_WORLD, &send[3]);
+
+        MPI_Recv_init(&bufferH[k][l], count, type, locality, getTag(myRank, receiveTags[border][0]), MPI_COMM_WORLD, &receive[0]);
+        MPI_Recv_init(&bufferHu[k][l], count, type, locality, getTag(myRank, receiveTags[border][1]), MPI_COMM_WORLD, &receive[1]);
+        MPI_Recv_init(&bufferHv[k][l], count, type, locality, getTag(myRank, receiveTags[border][2]), MPI_COMM_WORLD, &receive[2]);
+        MPI_Recv_init(&borderTimestep[border], 1, MPI_TIME_TYPE, locality, getTag(myRank, receiveTags[border][3]), MPI_COMM_WORLD, &receive[3]);
+    }
+}
+
+void SWE_DimensionalSplittingMPIOverdecomp::freeMpiType() {
+    for (int k = 0; k < 16; k++) {
+        if (sendRequests[k] != MPI_REQUEST_NULL)
+            MPI_Request_free(&sendRequests[k]);
+        if (receiveRequests[k] != MPI_REQUEST_NULL)
+            MPI_Request_free(&receiveRequests[k]);
+    }
+	MPI_Type_free(&HORIZONTAL_BOUNDARY);
+}
+
 
 
 void SWE_DimensionalSplittingMPIOverdecomp::recvBathymetry() {
@@ -183,20 +295,17 @@ void SWE_DimensionalSplittingMPIOverdecomp::recvBathymetry() {
         recvReqs[BND_RIGHT] = MPI_REQUEST_NULL;
     }
 
+    // The rows are received in one message each, see HORIZONTAL_BOUNDARY
     if (boundaryType[BND_BOTTOM] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Irecv(&b[i][0], 1, MPI_FLOAT, neighbourLocality[BND_BOTTOM], getTag(myRank,MPI_TAG_OUT_B_TOP), MPI_COMM_WORLD,
-                      &recvReqs[BND_BOTTOM]);
-        }
+        MPI_Irecv(&b[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank,MPI_TAG_OUT_B_TOP),
+                  MPI_COMM_WORLD, &recvReqs[BND_BOTTOM]);
     } else {
         recvReqs[BND_BOTTOM] = MPI_REQUEST_NULL;
     }
 
     if (boundaryType[BND_TOP] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Irecv(&b[i][ny + 1], 1, MPI_FLOAT, neighbourLocality[BND_TOP], getTag(myRank,MPI_TAG_OUT_B_BOTTOM), MPI_COMM_WORLD,
-                      &recvReqs[BND_TOP]);
-        }
+        MPI_Irecv(&b[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank,MPI_TAG_OUT_B_BOTTOM),
+                  MPI_COMM_WORLD, &recvReqs[BND_TOP]);
     } else {
         recvReqs[BND_TOP] = MPI_REQUEST_NULL;
     }
@@ -251,16 +360,14 @@ void SWE_DimensionalSplittingMPIOverdecomp::sendBathymetry() {
         MPI_Request_free(&req);
     }
     if (boundaryType[BND_BOTTOM] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Isend(&b[i][1], 1, MPI_FLOAT, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM],MPI_TAG_OUT_B_BOTTOM), MPI_COMM_WORLD, &req);
-            MPI_Request_free(&req);
-        }
+        MPI_Isend(&b[1][1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM],MPI_TAG_OUT_B_BOTTOM),
+                  MPI_COMM_WORLD, &req);
+        MPI_Request_free(&req);
     }
     if (boundaryType[BND_TOP] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Isend(&b[i][ny], 1, MPI_FLOAT, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP],MPI_TAG_OUT_B_TOP), MPI_COMM_WORLD, &req);
-            MPI_Request_free(&req);
-        }
+        MPI_Isend(&b[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP],MPI_TAG_OUT_B_TOP),
+                  MPI_COMM_WORLD, &req);
+        MPI_Request_free(&req);
     }
 
 }
@@ -272,6 +379,10 @@ void SWE_DimensionalSplittingMPIOverdecomp::setGhostLayer() {
     collector.startCounter(CollectorChameleon::CTR_EXCHANGE);
     if (boundaryType[BND_RIGHT] == CONNECT_WITHIN_RANK && isReceivable(BND_RIGHT)) {
         borderTimestep[BND_RIGHT] = right->getTotalLocalTimestep();
+#if defined(SHARED_EDGE_COLUMNS)
+        // The x-sweep reads the edge column of the neighbour in place
+        if (!sharedEdgeColumn[BND_RIGHT])
+#endif
         for(int i = 1; i < ny+1; i++) {
             bufferH[nx+1][i] = right->getWaterHeight()[1][i];
             bufferHu[nx+1][i] = right->getMomentumHorizontal()[1][i];
@@ -280,6 +391,10 @@ void SWE_DimensionalSplittingMPIOverdecomp::setGhostLayer() {
     }
     if (boundaryType[BND_LEFT] == CONNECT_WITHIN_RANK && isReceivable(BND_LEFT)) {
         borderTimestep[BND_LEFT] = left->getTotalLocalTimestep();
+#if defined(SHARED_EDGE_COLUMNS)
+        // The x-sweep reads the edge column of the neighbour in place
+        if (!sharedEdgeColumn[BND_LEFT])
+#endif
         for(int i = 1; i < ny+1; i++) {
             bufferH[0][i] = left->getWaterHeight()[left->nx][i];
             bufferHu[0][i] = left->getMomentumHorizontal()[left->nx][i];
@@ -302,74 +417,16 @@ void SWE_DimensionalSplittingMPIOverdecomp::setGhostLayer() {
             bufferHv[i][0] = bottom->getMomentumVertical()[i][bottom->ny];
         }
     }
-    MPI_Request req;
-    float totalLocalTimestep = getTotalLocalTimestep();
-    if (boundaryType[BND_LEFT] == CONNECT && isSendable(BND_LEFT)) {
-        int startIndex = ny + 2 + 1;
-
-        MPI_Isend(h.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_OUT_H_LEFT), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(hu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_OUT_HU_LEFT), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(hv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_OUT_HV_LEFT), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(neighbourRankId[BND_LEFT], MPI_TAG_TIMESTEP_LEFT), MPI_COMM_WORLD,&req);
-        MPI_Request_free(&req);
-
-    }
-    if (boundaryType[BND_RIGHT] == CONNECT && isSendable(BND_RIGHT)) {
-        int startIndex = nx * (ny + 2) + 1;
-
-        MPI_Isend(h.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_OUT_H_RIGHT), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(hu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HU_RIGHT), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(hv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HV_RIGHT), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(neighbourRankId[BND_RIGHT], MPI_TAG_TIMESTEP_RIGHT),MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-    }
-    if (boundaryType[BND_BOTTOM] == CONNECT && isSendable(BND_BOTTOM)) {
-
-        //int code =
-        MPI_Isend(&h[1][1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_H_BOTTOM), MPI_COMM_WORLD, &req);
-        //if(code != MPI_SUCCESS)
-        //	printf("%d: No success %d\n", myRank, code);
-        MPI_Request_free(&req);
-
-        MPI_Isend(&hu[1][1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_HU_BOTTOM), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(&hv[1][1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_HV_BOTTOM), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-        //printf("%d: Sent to bottom %d, %f at %f\n", myRank, neighbourRankId[BND_BOTTOM], h[1][1], originX);
-
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_BOTTOM], getTag(neighbourRankId[BND_BOTTOM], MPI_TAG_TIMESTEP_BOTTOM),MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-    }
-    if (boundaryType[BND_TOP] == CONNECT && isSendable(BND_TOP)) {
-
-        MPI_Isend(&h[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP], MPI_TAG_OUT_H_TOP), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(&hu[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP], MPI_TAG_OUT_HU_TOP), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-
-        MPI_Isend(&hv[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP], MPI_TAG_OUT_HV_TOP), MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-        //printf("%d: Sent to top %d, %f at %f\n", myRank, neighbourRankId[BND_TOP], h[1][ny], originX);
-
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourLocality[BND_TOP], getTag(neighbourRankId[BND_TOP], MPI_TAG_TIMESTEP_TOP), MPI_COMM_WORLD,&req);
-        MPI_Request_free(&req);
+    // The sends of the previous exchange have to be completed before they are started again.
+    // They are not waited for at the end of the previous exchange, since the matching receives of
+    // other blocks of the neighbouring locality may only be started after this locality's blocks have received.
+    MPI_Waitall(16, sendRequests, MPI_STATUSES_IGNORE);
 
+    // Four messages per boundary: h, hu, hv and the timestep, see connectNeighbours()
+    sentTimestep = getTotalLocalTimestep();
+    for (int border = 0; border < 4; border++) {
+        if (boundaryType[border] == CONNECT && isSendable(static_cast<Boundary>(border)))
+            MPI_Startall(4, &sendRequests[4 * border]);
     }
     /*printf("%d: send   %d:%d %d:%d %d:%d %d:%d \n", myRank,
             neighbourRankId[BND_LEFT],getTag(neighbourRankId[BND_LEFT], MPI_TAG_TIMESTEP_LEFT)
@@ -392,92 +449,284 @@ void SWE_DimensionalSplittingMPIOverdecomp::setGhostLayer() {
 
 }
 
+void SWE_DimensionalSplittingMPIOverdecomp::setProgressInterval(int columns) {
+    progressInterval = columns;
+}
+
+/**
+ * Tests the sends of the last exchange every progressInterval columns, so MPI progresses them
+ * while the block computes. They are waited for at the start of the next exchange otherwise,
+ * e.g. when the neighbouring locality did not receive in this step with local timestepping.
+ * The receives are always completed before the block computes, see receiveGhostLayer().
+ */
+void SWE_DimensionalSplittingMPIOverdecomp::progressSends(int i) {
+    if (progressInterval > 0 && i % progressInterval == 0) {
+        // Completed sends become inactive, setGhostLayer() does not wait for them anymore
+        int sent;
+        MPI_Testall(16, sendRequests, &sent, MPI_STATUSES_IGNORE);
+    }
+}
+
 void SWE_DimensionalSplittingMPIOverdecomp::receiveGhostLayer() {
 	/***********
 	 * RECEIVE *
 	 **********/
 
-    // The requests generated by the Isends are immediately freed, since we will wait on the requests generated by the corresponding receives
+    startReceiveGhostLayer();
 
-   // std::cout << myRank << "| start recv\n";
+    // Requests which have not been started are inactive and complete immediately
+	int code = MPI_Waitall(16, receiveRequests, MPI_STATUSES_IGNORE);
+	if(code != MPI_SUCCESS){
+        printf("%d: No success %d  %d:%d:%d:%d:\n", myRank, code,getTag(myRank, MPI_TAG_TIMESTEP_RIGHT),getTag(myRank, MPI_TAG_TIMESTEP_LEFT)
+                                                            ,getTag(myRank, MPI_TAG_TIMESTEP_TOP), getTag(myRank, MPI_TAG_TIMESTEP_BOTTOM));
 
-    MPI_Status status;
-	// 4 Boundaries times 3 arrays (h, hu, hv) means 12 requests
-	MPI_Request recvReqs[16];
-	MPI_Status stati[16];
+    }
 
+    finishReceiveGhostLayer();
+}
 
+void SWE_DimensionalSplittingMPIOverdecomp::startReceiveGhostLayer() {
+    for (int border = 0; border < 4; border++) {
+        if (boundaryType[border] == CONNECT && isReceivable(static_cast<Boundary>(border)))
+            MPI_Startall(4, &receiveRequests[4 * border]);
+    }
+}
 
-    if (boundaryType[BND_LEFT] == CONNECT && isReceivable(BND_LEFT)) {
-		int startIndex = 1;
+bool SWE_DimensionalSplittingMPIOverdecomp::testReceiveGhostLayer() {
+    int received;
+    MPI_Testall(16, receiveRequests, &received, MPI_STATUSES_IGNORE);
+    return received;
+}
 
-        MPI_Irecv(bufferH.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT],getTag(myRank, MPI_TAG_OUT_H_RIGHT), MPI_COMM_WORLD, &recvReqs[0]);
-        MPI_Irecv(bufferHu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT],getTag(myRank, MPI_TAG_OUT_HU_RIGHT), MPI_COMM_WORLD, &recvReqs[1]);
-        MPI_Irecv(bufferHv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_LEFT],getTag(myRank, MPI_TAG_OUT_HV_RIGHT), MPI_COMM_WORLD, &recvReqs[2]);
-        MPI_Irecv(&borderTimestep[BND_LEFT], 1, MPI_FLOAT, neighbourLocality[BND_LEFT], getTag(myRank, MPI_TAG_TIMESTEP_RIGHT), MPI_COMM_WORLD, &recvReqs[3]);
+bool SWE_DimensionalSplittingMPIOverdecomp::testSendGhostLayer() {
+    int sent;
+    MPI_Testall(16, sendRequests, &sent, MPI_STATUSES_IGNORE);
+    return sent;
+}
 
-    } else {
-        recvReqs[0] = MPI_REQUEST_NULL;
-        recvReqs[1] = MPI_REQUEST_NULL;
-        recvReqs[2] = MPI_REQUEST_NULL;
-        recvReqs[3] = MPI_REQUEST_NULL;
+void SWE_DimensionalSplittingMPIOverdecomp::finishReceiveGhostLayer() {
+    checkAllGhostlayers();
+    collector.stopCounter(CollectorChameleon::CTR_EXCHANGE);
+}
 
-    }
 
-	if (boundaryType[BND_RIGHT] == CONNECT && isReceivable(BND_RIGHT)) {
-		int startIndex = (nx + 1) * (ny + 2) + 1;
-        MPI_Irecv(bufferH.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT],getTag(myRank, MPI_TAG_OUT_H_LEFT), MPI_COMM_WORLD, &recvReqs[4]);
-        MPI_Irecv(bufferHu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT],getTag(myRank, MPI_TAG_OUT_HU_LEFT), MPI_COMM_WORLD, &recvReqs[5]);
-        MPI_Irecv(bufferHv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourLocality[BND_RIGHT],getTag(myRank, MPI_TAG_OUT_HV_LEFT), MPI_COMM_WORLD, &recvReqs[6]);
-        MPI_Irecv(&borderTimestep[BND_RIGHT], 1, MPI_FLOAT, neighbourLocality[BND_RIGHT], getTag(myRank, MPI_TAG_TIMESTEP_LEFT), MPI_COMM_WORLD, &recvReqs[7]);
+#if defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+/**
+ * Computes the net updates of the edges with row index jBegin <= j < jEnd
+ * between cell column i - 1 and i.
+ *
+ * @return maximum wave speed of the edges
+ */
+float SWE_DimensionalSplittingMPIOverdecomp::computeVerticalEdges(int i, int jBegin, int jEnd) {
+#if defined(BATCHED_SOLVER)
+    return batchSolver.computeNetUpdates (
+            jEnd - jBegin,
+            h[i - 1] + jBegin, h[i] + jBegin,
+            hu[i - 1] + jBegin, hu[i] + jBegin,
+            edgeBathymetry.vertical[i - 1] + jBegin - 1,
+            hNetUpdatesLeft[i - 1] + jBegin - 1, hNetUpdatesRight[i - 1] + jBegin - 1,
+            huNetUpdatesLeft[i - 1] + jBegin - 1, huNetUpdatesRight[i - 1] + jBegin - 1
+    );
+#else
+    float maxWaveSpeed = (float) 0.;
 
-    } else {
-        recvReqs[4] = MPI_REQUEST_NULL;
-        recvReqs[5] = MPI_REQUEST_NULL;
-        recvReqs[6] = MPI_REQUEST_NULL;
-        recvReqs[7] = MPI_REQUEST_NULL;
+#if defined(VECTORIZE)
+#pragma omp simd reduction(max:maxWaveSpeed)
+#endif // VECTORIZE
+    for (int j = jBegin; j < jEnd; j++) {
+        float maxEdgeSpeed;
+
+        solver.computeNetUpdates (
+                h[i - 1][j], h[i][j],
+                hu[i - 1][j], hu[i][j],
+                b[i - 1][j], b[i][j],
+                hNetUpdatesLeft[i - 1][j - 1], hNetUpdatesRight[i - 1][j - 1],
+                huNetUpdatesLeft[i - 1][j - 1], huNetUpdatesRight[i - 1][j - 1],
+                maxEdgeSpeed
+        );
+        maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
+    }
+
+    return maxWaveSpeed;
+#endif // BATCHED_SOLVER
+}
 
-    }
+/**
+ * Computes the net updates of the edges between cell row j - 1 and j, jBegin <= j < jEnd,
+ * in cell column i.
+ *
+ * @return maximum wave speed of the edges
+ */
+float SWE_DimensionalSplittingMPIOverdecomp::computeHorizontalEdges(int i, int jBegin, int jEnd) {
+#if defined(BATCHED_SOLVER)
+    return batchSolver.computeNetUpdates (
+            jEnd - jBegin,
+            h[i] + jBegin - 1, h[i] + jBegin,
+            hv[i] + jBegin - 1, hv[i] + jBegin,
+            edgeBathymetry.horizontal[i - 1] + jBegin - 1,
+            hNetUpdatesBelow[i - 1] + jBegin - 1, hNetUpdatesAbove[i - 1] + jBegin - 1,
+            hvNetUpdatesBelow[i - 1] + jBegin - 1, hvNetUpdatesAbove[i - 1] + jBegin - 1
+    );
+#else
+    float maxWaveSpeed = (float) 0.;
 
-	if (boundaryType[BND_BOTTOM] == CONNECT && isReceivable(BND_BOTTOM)) {
+#if defined(VECTORIZE)
+#pragma omp simd reduction(max:maxWaveSpeed)
+#endif // VECTORIZE
+    for (int j = jBegin; j < jEnd; j++) {
+        float maxEdgeSpeed;
+
+        solver.computeNetUpdates (
+                h[i][j - 1], h[i][j],
+                hv[i][j - 1], hv[i][j],
+                b[i][j - 1], b[i][j],
+                hNetUpdatesBelow[i - 1][j - 1], hNetUpdatesAbove[i - 1][j - 1],
+                hvNetUpdatesBelow[i - 1][j - 1], hvNetUpdatesAbove[i - 1][j - 1],
+                maxEdgeSpeed
+        );
+        maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
+    }
+
+    return maxWaveSpeed;
+#endif // BATCHED_SOLVER
+}
 
-        MPI_Irecv(&bufferH[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_OUT_H_TOP),MPI_COMM_WORLD, &recvReqs[8]);
-        MPI_Irecv(&bufferHu[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_OUT_HU_TOP),MPI_COMM_WORLD, &recvReqs[9]);
-        MPI_Irecv(&bufferHv[1][0], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_OUT_HV_TOP),MPI_COMM_WORLD, &recvReqs[10]);
-        MPI_Irecv(&borderTimestep[BND_BOTTOM], 1, MPI_FLOAT, neighbourLocality[BND_BOTTOM], getTag(myRank, MPI_TAG_TIMESTEP_TOP),MPI_COMM_WORLD, &recvReqs[11]);
+#if defined(DRY_TILE_SKIPPING)
+/**
+ * Computes the net updates of all edges adjacent to a cell of an active tile.
+ * Edges of skipped tiles lie between two dry cells at rest, they do not produce updates or wave speeds.
+ * An edge on the border between two active tiles is only computed by the right/upper tile.
+ *
+ * @param computedEdges is set to the number of edges that were solved
+ * @return maximum wave speed of the computed edges
+ */
+float SWE_DimensionalSplittingMPIOverdecomp::computeActiveTileNetUpdates(long &computedEdges) {
+    float maxWaveSpeed = (float) 0.;
+    computedEdges = 0;
 
-    } else {
-        recvReqs[8] = MPI_REQUEST_NULL;
-        recvReqs[9] = MPI_REQUEST_NULL;
-        recvReqs[10] = MPI_REQUEST_NULL;
-        recvReqs[11] = MPI_REQUEST_NULL;
+    // The ghost layer has just been set, so neighbouring blocks can activate the border tiles
+    tileActivity.updateActive(h, hu, hv);
+
+    const int tilesX = tileActivity.getTilesX();
+    const int tilesY = tileActivity.getTilesY();
+
+    for (int tileX = 0; tileX < tilesX; tileX++) {
+        for (int tileY = 0; tileY < tilesY; tileY++) {
+            if (!tileActivity.isActive(tileX, tileY))
+                continue;
+
+            const int iBegin = tileActivity.xBegin(tileX);
+            const int iEnd = tileActivity.xEnd(tileX);
+            const int jBegin = tileActivity.yBegin(tileY);
+            const int jEnd = tileActivity.yEnd(tileY);
+
+            // Right and upper border of the tile, unless the next tile computes them
+            const bool rightBorder = tileX + 1 == tilesX || !tileActivity.isActive(tileX + 1, tileY);
+            const bool upperBorder = tileY + 1 == tilesY || !tileActivity.isActive(tileX, tileY + 1);
+            const int iVerticalEnd = rightBorder ? iEnd + 1 : iEnd;
+            const int jHorizontalEnd = upperBorder ? jEnd + 1 : jEnd;
+
+            for (int i = iBegin; i < iVerticalEnd; i++) {
+                maxWaveSpeed = std::max(maxWaveSpeed, computeVerticalEdges(i, jBegin, jEnd));
+                progressSends(i);
+            }
+            for (int i = iBegin; i < iEnd; i++) {
+                maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, jBegin, jHorizontalEnd));
+                progressSends(i);
+            }
+
+            computedEdges += (iVerticalEnd - iBegin) * (jEnd - jBegin) + (iEnd - iBegin) * (jHorizontalEnd - jBegin);
+        }
     }
 
-	if (boundaryType[BND_TOP] == CONNECT && isReceivable(BND_TOP)) {
+    return maxWaveSpeed;
+}
+#endif // DRY_TILE_SKIPPING
 
-        MPI_Irecv(&bufferH[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_OUT_H_BOTTOM),MPI_COMM_WORLD, &recvReqs[12]);
-        MPI_Irecv(&bufferHu[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_OUT_HU_BOTTOM),MPI_COMM_WORLD, &recvReqs[13]);
-        MPI_Irecv(&bufferHv[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_OUT_HV_BOTTOM),MPI_COMM_WORLD, &recvReqs[14]);
-        MPI_Irecv(&borderTimestep[BND_TOP], 1, MPI_FLOAT, neighbourLocality[BND_TOP], getTag(myRank, MPI_TAG_TIMESTEP_BOTTOM),MPI_COMM_WORLD, &recvReqs[15]);
+#if defined(WAVEFRONT_TRACKING)
+/**
+ * Computes the net updates of all edges adjacent to a cell inside the wavefront box.
+ * The edges outside of the box are still in their initial state and produce zero net updates,
+ * their wave speeds are bounded by WavefrontBox::getOutsideWaveSpeed().
+ *
+ * @param computedEdges is set to the number of edges that were solved
+ * @return maximum wave speed of all edges
+ */
+float SWE_DimensionalSplittingMPIOverdecomp::computeWavefrontNetUpdates(long &computedEdges) {
+    // The ghost layer has just been set, so changes of neighbouring blocks are added to the box
+    wavefrontBox.checkGhostLayer(h, hu, hv);
 
-    } else {
-        recvReqs[12] = MPI_REQUEST_NULL;
-        recvReqs[13] = MPI_REQUEST_NULL;
-        recvReqs[14] = MPI_REQUEST_NULL;
-        recvReqs[15] = MPI_REQUEST_NULL;
+    const int iBegin = wavefrontBox.getIBegin();
+    const int iEnd = wavefrontBox.getIEnd();
+    const int jBegin = wavefrontBox.getJBegin();
+    const int jEnd = wavefrontBox.getJEnd();
+
+    float maxWaveSpeed = wavefrontBox.getOutsideWaveSpeed();
+    computedEdges = 0;
+    if (iBegin >= iEnd || jBegin >= jEnd)
+        return maxWaveSpeed;
+
+    for (int i = iBegin; i < iEnd + 1; i++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeVerticalEdges(i, jBegin, jEnd));
+        progressSends(i);
+    }
+    for (int i = iBegin; i < iEnd; i++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, jBegin, jEnd + 1));
+        progressSends(i);
     }
 
-	int code = MPI_Waitall(16, recvReqs, stati);
-	if(code != MPI_SUCCESS){
-        printf("%d: No success %d  %d:%d:%d:%d:\n", myRank, code,getTag(myRank, MPI_TAG_TIMESTEP_RIGHT),getTag(myRank, MPI_TAG_TIMESTEP_LEFT)
-                                                            ,getTag(myRank, MPI_TAG_TIMESTEP_TOP), getTag(myRank, MPI_TAG_TIMESTEP_BOTTOM));
+    computedEdges = (long) (iEnd - iBegin + 1) * (jEnd - jBegin) + (long) (iEnd - iBegin) * (jEnd - jBegin + 1);
+    return maxWaveSpeed;
+}
 
+/**
+ * Marks the cells inside the wavefront box that received a non-zero net update from any of their edges
+ * and grows the box for the next timestep.
+ */
+void SWE_DimensionalSplittingMPIOverdecomp::trackWavefront() {
+    for (int i = wavefrontBox.getIBegin(); i < wavefrontBox.getIEnd(); i++) {
+        for (int j = wavefrontBox.getJBegin(); j < wavefrontBox.getJEnd(); j++) {
+            if (hNetUpdatesRight[i - 1][j - 1] != 0 || hNetUpdatesLeft[i][j - 1] != 0
+                || huNetUpdatesRight[i - 1][j - 1] != 0 || huNetUpdatesLeft[i][j - 1] != 0
+                || hNetUpdatesAbove[i - 1][j - 1] != 0 || hNetUpdatesBelow[i - 1][j] != 0
+                || hvNetUpdatesAbove[i - 1][j - 1] != 0 || hvNetUpdatesBelow[i - 1][j] != 0) {
+                wavefrontBox.markChanged(i, j);
+            }
+        }
     }
 
-    checkAllGhostlayers();
-    collector.stopCounter(CollectorChameleon::CTR_EXCHANGE);
+    wavefrontBox.advance(h, hu, hv, g);
 }
+#endif // WAVEFRONT_TRACKING
 
+/**
+ * Updates the cells iBegin <= i < iEnd, jBegin <= j < jEnd with the computed net-updates.
+ */
+void SWE_DimensionalSplittingMPIOverdecomp::updateCells(float dt, int iBegin, int iEnd, int jBegin, int jEnd) {
+    for (int i = iBegin; i < iEnd; i++) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = jBegin; j < jEnd; j++) {
+            h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
+            hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
+            hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
+
+            if (h[i][j] < 0) {
+#ifndef NDEBUG
+                if (h[i][j] < -0.1) {
+                    std::cerr << "Warning, negative height: (i,j)=(" << i << "," << j << ")=" << h[i][j] << std::endl;
+                    std::cerr << "         b: " << b[i][j] << std::endl;
+                }
+#endif // NDEBUG
+                //zero (small) negative depths
+                h[i][j] = hu[i][j] = hv[i][j] = 0.;
+            } else if (h[i][j] < 0.1)
+                hu[i][j] = hv[i][j] = 0.; //no water, no speed!
+        }
+    }
+}
+#endif // DRY_TILE_SKIPPING || WAVEFRONT_TRACKING
 
 /**
  * Compute net updates for the block.
@@ -486,6 +735,20 @@ void SWE_DimensionalSplittingMPIOverdecomp::receiveGhostLayer() {
  */
 void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
     if (!allGhostlayersInSync()) return;
+#if defined(BATCHED_SOLVER)
+    // The bathymetry is static once it has been exchanged, so the edge differences are computed on first use
+    if (!edgeBathymetry.isInitialized()) {
+        edgeBathymetry = EdgeBathymetry(nx, ny);
+        edgeBathymetry.compute(b);
+    }
+#endif // BATCHED_SOLVER
+#if defined(DRY_TILE_SKIPPING)
+    long computedEdges;
+    float maxWaveSpeed = computeActiveTileNetUpdates(computedEdges);
+#elif defined(WAVEFRONT_TRACKING)
+    long computedEdges;
+    float maxWaveSpeed = computeWavefrontNetUpdates(computedEdges);
+#else
 //maximum (linearized) wave speed within one iteration
     float maxWaveSpeed = (float) 0.;
     /***************************************************************************************
@@ -493,6 +756,27 @@ void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
      **************************************************************************************/
 
     for (int i = 1; i < nx+2; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+        // The outermost edges read the ghost columns or the edge columns of on-rank neighbours
+        const float *hLeft = i == 1 ? hColumnLeft : h[i - 1];
+        const float *huLeft = i == 1 ? huColumnLeft : hu[i - 1];
+        const float *hRight = i == nx + 1 ? hColumnRight : h[i];
+        const float *huRight = i == nx + 1 ? huColumnRight : hu[i];
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny,
+                hLeft + 1, hRight + 1,
+                huLeft + 1, huRight + 1,
+                edgeBathymetry.vertical[i - 1],
+                hNetUpdatesLeft[edgeColumn], hNetUpdatesRight[edgeColumn],
+                huNetUpdatesLeft[edgeColumn], huNetUpdatesRight[edgeColumn]
+        ));
+#else
         const int ny_end = ny+1;
 
 #if defined(VECTORIZE)
@@ -505,16 +789,38 @@ void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
 
 
             solver.computeNetUpdates (
-                    h[i - 1][j], h[i][j],
-                    hu[i - 1][j], hu[i][j],
+                    hLeft[j], hRight[j],
+                    huLeft[j], huRight[j],
                     b[i - 1][j], b[i][j],
-                    hNetUpdatesLeft[i - 1][j - 1], hNetUpdatesRight[i - 1][j - 1],
-                    huNetUpdatesLeft[i - 1][j - 1], huNetUpdatesRight[i - 1][j - 1],
+                    hNetUpdatesLeft[edgeColumn][j - 1], hNetUpdatesRight[edgeColumn][j - 1],
+                    huNetUpdatesLeft[edgeColumn][j - 1], huNetUpdatesRight[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
             maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
         }
-
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // The edges complete cell i - 1 and are the first contribution to cell i
+        if (i > 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i - 1][j] += hNetUpdatesLeft[0][j - 1] / dx;
+                dhu[i - 1][j] += huNetUpdatesLeft[0][j - 1] / dx;
+            }
+        }
+        if (i < nx + 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i][j] = hNetUpdatesRight[0][j - 1] / dx;
+                dhu[i][j] = huNetUpdatesRight[0][j - 1] / dx;
+            }
+        }
+#endif // ACCUMULATE_NET_UPDATES
+        progressSends(i);
     }
 
 
@@ -523,6 +829,22 @@ void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
      **************************************************************************************/
 
     for (int i=1; i < nx + 1; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny + 1,
+                h[i], h[i] + 1,
+                hv[i], hv[i] + 1,
+                edgeBathymetry.horizontal[i - 1],
+                hNetUpdatesBelow[edgeColumn], hNetUpdatesAbove[edgeColumn],
+                hvNetUpdatesBelow[edgeColumn], hvNetUpdatesAbove[edgeColumn]
+        ));
+#else
         const int ny_end = ny+2;
 
 #if defined(VECTORIZE)
@@ -537,8 +859,8 @@ void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
                     h[i][j - 1], h[i][j],
                     hv[i][j - 1], hv[i][j],
                     b[i][j - 1], b[i][j],
-                    hNetUpdatesBelow[i - 1][j - 1], hNetUpdatesAbove[i - 1][j - 1],
-                    hvNetUpdatesBelow[i - 1][j - 1], hvNetUpdatesAbove[i - 1][j - 1],
+                    hNetUpdatesBelow[edgeColumn][j - 1], hNetUpdatesAbove[edgeColumn][j - 1],
+                    hvNetUpdatesBelow[edgeColumn][j - 1], hvNetUpdatesAbove[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
 
@@ -547,7 +869,20 @@ void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
             //maxTestSpeed = std::max (maxTestSpeed, maxEdgeSpeed);
 
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Add the contributions of the edges below and above cell (i, j)
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny + 1; j++) {
+            dh[i][j] += (hNetUpdatesAbove[0][j - 1] + hNetUpdatesBelow[0][j]) / dy;
+            dhv[i][j] = (hvNetUpdatesAbove[0][j - 1] + hvNetUpdatesBelow[0][j]) / dy;
+        }
+#endif // ACCUMULATE_NET_UPDATES
+        progressSends(i);
     }
+#endif // DRY_TILE_SKIPPING / WAVEFRONT_TRACKING
 
     if (maxWaveSpeed > 0.00001) {
 
@@ -559,7 +894,12 @@ void SWE_DimensionalSplittingMPIOverdecomp::computeNumericalFluxes() {
         maxTimestep = std::numeric_limits<float>::max ();
     }
 
+#if defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+    // Only the edges that were actually solved
+    collector.addFlops(computedEdges * 135);
+#else
     collector.addFlops(2*nx * ny * 135);
+#endif
     //collector.addTimestep(maxTimestep);
 }
 
@@ -573,6 +913,25 @@ void SWE_DimensionalSplittingMPIOverdecomp::updateUnknowns(float dt) {
     if (!allGhostlayersInSync()) return;
 //update cell averages with the net-updates
     dt=maxTimestep;
+#if defined(DRY_TILE_SKIPPING)
+    for (int tileX = 0; tileX < tileActivity.getTilesX(); tileX++) {
+        for (int tileY = 0; tileY < tileActivity.getTilesY(); tileY++) {
+            if (tileActivity.isActive(tileX, tileY)) {
+                updateCells(dt, tileActivity.xBegin(tileX), tileActivity.xEnd(tileX),
+                            tileActivity.yBegin(tileY), tileActivity.yEnd(tileY));
+            }
+        }
+    }
+    // Skipped tiles did not change, only the active ones have to be rescanned
+    tileActivity.updateWet(h, hu, hv);
+    return;
+#endif // DRY_TILE_SKIPPING
+#if defined(WAVEFRONT_TRACKING)
+    updateCells(dt, wavefrontBox.getIBegin(), wavefrontBox.getIEnd(), wavefrontBox.getJBegin(), wavefrontBox.getJEnd());
+    // The box grows only after the update, the net updates outside of it have not been computed
+    trackWavefront();
+    return;
+#endif // WAVEFRONT_TRACKING
     for (int i = 1; i < nx+1; i++) {
         const int ny_end = ny+1;
 
@@ -583,9 +942,15 @@ void SWE_DimensionalSplittingMPIOverdecomp::updateUnknowns(float dt) {
 #endif // VECTORIZE
 
         for (int j = 1; j < ny_end; j++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+            h[i][j] -= dt * dh[i][j];
+            hu[i][j] -= dt * dhu[i][j];
+            hv[i][j] -= dt * dhv[i][j];
+#else
             h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
             hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
             hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
+#endif // ACCUMULATE_NET_UPDATES
 
             if (h[i][j] < 0) {
                 //TODO: dryTol
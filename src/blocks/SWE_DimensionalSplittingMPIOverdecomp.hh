@@ -47,6 +47,32 @@
 #elif WAVE_PROPAGATION_SOLVER==2
 #include "solvers/AugRie.hpp"
 #endif
+
+#if defined(BATCHED_SOLVER)
+#include "tools/HLLEBatch.hh"
+#include "tools/EdgeBathymetry.hh"
+#endif
+
+#if defined(DRY_TILE_SKIPPING)
+#if defined(ACCUMULATE_NET_UPDATES)
+#error "DRY_TILE_SKIPPING requires the full net-update arrays, it cannot be combined with ACCUMULATE_NET_UPDATES"
+#endif
+#include "tools/TileActivity.hh"
+#endif
+
+#if defined(WAVEFRONT_TRACKING)
+#if defined(ACCUMULATE_NET_UPDATES) || defined(DRY_TILE_SKIPPING)
+#error "WAVEFRONT_TRACKING requires the full net-update arrays and its own traversal, it cannot be combined with ACCUMULATE_NET_UPDATES or DRY_TILE_SKIPPING"
+#endif
+#include "tools/WavefrontBox.hh"
+#endif
+
+// The x-sweep reads the edge columns of on-rank neighbours in place, see connectLocalNeighbours().
+// Dry tile skipping and wavefront tracking scan the ghost layers themselves, so these are still copied.
+#if !defined(DRY_TILE_SKIPPING) && !defined(WAVEFRONT_TRACKING)
+#define SHARED_EDGE_COLUMNS
+#endif
+
 class SWE_DimensionalSplittingMPIOverdecomp : public SWE_Block<Float2DNative> {
 	public:
 		// Constructor/Destructor
@@ -57,6 +83,14 @@ class SWE_DimensionalSplittingMPIOverdecomp : public SWE_Block<Float2DNative> {
 		// Interface methods
 		void setGhostLayer();
 		void receiveGhostLayer();
+
+        // receiveGhostLayer() in steps, so a scheduler can test the receives without blocking a thread:
+        // start them, test them until they have completed, then process the ghost layers
+        void startReceiveGhostLayer();
+        bool testReceiveGhostLayer();
+        void finishReceiveGhostLayer();
+        // Whether the sends of the last exchange have completed, setGhostLayer() does not block then
+        bool testSendGhostLayer();
 		void computeNumericalFluxes();
 
 		void updateUnknowns(float dt);
@@ -71,8 +105,12 @@ class SWE_DimensionalSplittingMPIOverdecomp : public SWE_Block<Float2DNative> {
 		void freeMpiType();
 
         void connectNeighbourLocalities(int neighbourRankId[]);
+        void connectNeighbours(int neighbourRankId[]);
         void connectLocalNeighbours(std::array<std::shared_ptr<SWE_DimensionalSplittingMPIOverdecomp>,4> neighbourBlocks);
 
+        // Columns computed between two tests of the outstanding sends, 0 disables the tests (default)
+        void setProgressInterval(int columns);
+
         int neighbourLocality[4];
 
         CollectorChameleon collector;
@@ -92,6 +130,41 @@ class SWE_DimensionalSplittingMPIOverdecomp : public SWE_Block<Float2DNative> {
     solver::AugRie<float> solver;
 #endif
 
+#if defined(BATCHED_SOLVER)
+    //! Explicitly vectorized HLLE solver, used for whole columns of edges
+    solver::HLLEBatch batchSolver;
+    //! Bathymetry differences of all edges, computed once
+    EdgeBathymetry edgeBathymetry;
+#endif
+
+#if defined(DRY_TILE_SKIPPING)
+    // Tiles of tileSize x tileSize cells, tiles that are dry and at rest are skipped
+    static const int tileSize = 32;
+    TileActivity tileActivity;
+
+    // Net updates of all edges adjacent to the active tiles
+    float computeActiveTileNetUpdates(long &computedEdges);
+#endif
+
+#if defined(WAVEFRONT_TRACKING)
+    // Cells reached by a wave, the rest of the block is still at rest
+    WavefrontBox wavefrontBox;
+
+    // Net updates of all edges adjacent to the cells inside the wavefront box
+    float computeWavefrontNetUpdates(long &computedEdges);
+
+    // Adds the cells with non-zero net updates to the wavefront box
+    void trackWavefront();
+#endif
+
+#if defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+    float computeVerticalEdges(int i, int jBegin, int jEnd);
+
+    float computeHorizontalEdges(int i, int jBegin, int jEnd);
+
+    void updateCells(float dt, int iBegin, int iEnd, int jBegin, int jEnd);
+#endif
+
     // Temporary values after x-sweep and before y-sweep
 		Float2DNative hStar;
 		Float2DNative huStar;
@@ -109,11 +182,44 @@ class SWE_DimensionalSplittingMPIOverdecomp : public SWE_Block<Float2DNative> {
 		Float2DNative hvNetUpdatesBelow;
 		Float2DNative hvNetUpdatesAbove;
 
+#if defined(ACCUMULATE_NET_UPDATES)
+		// Net updates accumulated per cell and scaled by the cell size,
+		// the edge arrays above then only hold the edges of the current column
+		Float2DNative dh;
+		Float2DNative dhu;
+		Float2DNative dhv;
+#endif
+
 
 
 
     void sendBathymetry();
     void recvBathymetry();
+
+private:
+    // Persistent requests of the ghost layer messages, 4 per Boundary (h, hu, hv, timestep), see connectNeighbours()
+    MPI_Request sendRequests[16];
+    MPI_Request receiveRequests[16];
+
+    // Timestep sent with the ghost layers, the send requests point to it
+    TimeScalar sentTimestep;
+
+#if defined(SHARED_EDGE_COLUMNS)
+    // Columns of h and hu left of column 1 and right of column nx read by the x-sweep:
+    // the ghost columns, or the edge columns of on-rank neighbours, see connectLocalNeighbours()
+    const float *hColumnLeft;
+    const float *huColumnLeft;
+    const float *hColumnRight;
+    const float *huColumnRight;
+    // The ghost column at the border is not used and not copied, indexed by Boundary
+    bool sharedEdgeColumn[4] = {false, false, false, false};
+#endif
+
+    // Off by default, the blocks of a locality compute concurrently and would contend for MPI
+    int progressInterval = 0;
+
+    // Called by the kernels after column i
+    void progressSends(int i);
 };
 
 
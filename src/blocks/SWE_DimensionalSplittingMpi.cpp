@@ -50,9 +50,10 @@
  * @param l_ny Size of the computational domain in y-direction
  * @param l_dx Cell width
  * @param l_dy Cell height
+ * @param comm communicator of the blocks, the neighbour ranks are ranks of comm
  */
 SWE_DimensionalSplittingMpi::SWE_DimensionalSplittingMpi(int nx, int ny, float dx, float dy, float originX,
-                                                         float originY, bool localTimestepping) :
+                                                         float originY, bool localTimestepping, MPI_Comm comm) :
 /*
  * Important note concerning grid allocations:
  * Since index shifts all over the place are bug-prone and maintenance unfriendly,
@@ -66,8 +67,8 @@ SWE_DimensionalSplittingMpi::SWE_DimensionalSplittingMpi(int nx, int ny, float d
         SWE_Block(nx, ny, dx, dy, originX, originY, localTimestepping),
 
         // intermediate state Q after x-sweep
-        hStar(nx + 1, ny + 2),
-        huStar(nx + 1, ny + 2),
+        hStar(nx + 1, ny + 2, arena),
+        huStar(nx + 1, ny + 2, arena),
 
         /*
          * Temporary storage for the net updates per grid cell during a sweep.
@@ -75,122 +76,522 @@ SWE_DimensionalSplittingMpi::SWE_DimensionalSplittingMpi(int nx, int ny, float d
          * Left-going wave from the right edge, analogue for the left edge.
          * Down-going wave from the top edge, analogue for the bottom edge
          */
-
+#if defined(FUSED_KERNEL)
+        // Rolling window: the two vertical edges of the current column
+        hNetUpdatesLeft(2, ny + 2, arena),
+        hNetUpdatesRight(2, ny + 2, arena),
+
+        huNetUpdatesLeft(2, ny + 2, arena),
+        huNetUpdatesRight(2, ny + 2, arena),
+
+        // Rolling window: the horizontal edges of the current column
+        hNetUpdatesBelow(1, ny + 2, arena),
+        hNetUpdatesAbove(1, ny + 2, arena),
+
+        hvNetUpdatesBelow(1, ny + 2, arena),
+        hvNetUpdatesAbove(1, ny + 2, arena) {
+#elif defined(ACCUMULATE_NET_UPDATES)
+        // Only the edges of the current column are stored, see computeNumericalFluxes()
+        hNetUpdatesLeft(1, ny + 2, arena),
+        hNetUpdatesRight(1, ny + 2, arena),
+
+        huNetUpdatesLeft(1, ny + 2, arena),
+        huNetUpdatesRight(1, ny + 2, arena),
+
+        hNetUpdatesBelow(1, ny + 2, arena),
+        hNetUpdatesAbove(1, ny + 2, arena),
+
+        hvNetUpdatesBelow(1, ny + 2, arena),
+        hvNetUpdatesAbove(1, ny + 2, arena),
+
+        // Accumulated net updates per cell
+        dh(nx + 2, ny + 2, arena),
+        dhu(nx + 2, ny + 2, arena),
+        dhv(nx + 2, ny + 2, arena) {
+#else
         // For the x-sweep
-        hNetUpdatesLeft(nx + 2, ny + 2),
-        hNetUpdatesRight(nx + 2, ny + 2),
+        hNetUpdatesLeft(nx + 2, ny + 2, arena),
+        hNetUpdatesRight(nx + 2, ny + 2, arena),
 
-        huNetUpdatesLeft(nx + 2, ny + 2),
-        huNetUpdatesRight(nx + 2, ny + 2),
+        huNetUpdatesLeft(nx + 2, ny + 2, arena),
+        huNetUpdatesRight(nx + 2, ny + 2, arena),
 
         // For the y-sweep
-        hNetUpdatesBelow(nx + 1, ny + 2),
-        hNetUpdatesAbove(nx + 1, ny + 2),
-
-        hvNetUpdatesBelow(nx + 1, ny + 2),
-        hvNetUpdatesAbove(nx + 1, ny + 2) {
-
-    MPI_Type_vector(nx, 1, ny + 2, MPI_FLOAT, &HORIZONTAL_BOUNDARY);
+        hNetUpdatesBelow(nx + 1, ny + 2, arena),
+        hNetUpdatesAbove(nx + 1, ny + 2, arena),
+
+        hvNetUpdatesBelow(nx + 1, ny + 2, arena),
+        hvNetUpdatesAbove(nx + 1, ny + 2, arena) {
+#endif // FUSED_KERNEL
+    communicator = comm;
+
+#if defined(INTERLEAVED_STATE)
+    const int components = Float2DState::components;
+    MPI_Type_vector(ny, 3, components, MPI_STATE_TYPE, &CELL_COLUMN);
+    MPI_Type_commit(&CELL_COLUMN);
+    MPI_Type_vector(nx, 3, (ny + 2) * components, MPI_STATE_TYPE, &CELL_ROW);
+    MPI_Type_commit(&CELL_ROW);
+
+    sendLayer[BND_LEFT] = createLayerType(&sentTimestep, &h[1][1], CELL_COLUMN);
+    sendLayer[BND_RIGHT] = createLayerType(&sentTimestep, &h[nx][1], CELL_COLUMN);
+    sendLayer[BND_BOTTOM] = createLayerType(&sentTimestep, &h[1][1], CELL_ROW);
+    sendLayer[BND_TOP] = createLayerType(&sentTimestep, &h[1][ny], CELL_ROW);
+
+    // Without local timestepping the buffers are h, hu and hv themselves
+    receiveLayer[BND_LEFT] = createLayerType(&borderTimestep[BND_LEFT], &bufferH[0][1], CELL_COLUMN);
+    receiveLayer[BND_RIGHT] = createLayerType(&borderTimestep[BND_RIGHT], &bufferH[nx + 1][1], CELL_COLUMN);
+    receiveLayer[BND_BOTTOM] = createLayerType(&borderTimestep[BND_BOTTOM], &bufferH[1][0], CELL_ROW);
+    receiveLayer[BND_TOP] = createLayerType(&borderTimestep[BND_TOP], &bufferH[1][ny + 1], CELL_ROW);
+#else
+    MPI_Type_vector(nx, 1, ny + 2, MPI_STATE_TYPE, &HORIZONTAL_BOUNDARY);
     MPI_Type_commit(&HORIZONTAL_BOUNDARY);
 
+    // Pack buffers of the ghost layers: the timestep followed by h, hu and hv of the layer
+    int timestepSize;
+    MPI_Pack_size(1, MPI_TIME_TYPE, communicator, &timestepSize);
+    for (int border = 0; border < 4; border++) {
+        int i, j, count;
+        MPI_Datatype type;
+        getLayerCells(static_cast<Boundary>(border), false, i, j, count, type);
+
+        int cellsSize;
+        MPI_Pack_size(count, type, communicator, &cellsSize);
+        sendBuffer[border].resize(timestepSize + 3 * cellsSize);
+        receiveBuffer[border].resize(timestepSize + 3 * cellsSize);
+    }
+#endif
+
+#if defined(DRY_TILE_SKIPPING)
+    tileActivity = TileActivity(nx, ny, tileSize);
+#endif
+#if defined(WAVEFRONT_TRACKING)
+    wavefrontBox = WavefrontBox(nx, ny);
+#endif
 
 }
 
 void SWE_DimensionalSplittingMpi::freeMpiType() {
+#if defined(LAGGED_TIMESTEP)
+    // The reduction for the step after the last one
+    MPI_Wait(&timestepReduction, MPI_STATUS_IGNORE);
+    if (cflViolations > 0)
+        std::cerr << "Warning: the lagged timestep exceeded the CFL timestep in " << cflViolations << " steps" << std::endl;
+#endif
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+    // Collective on the node, the neighbours have consumed all mailboxes before
+    for (int border = 0; border < 4; border++) {
+        MPI_Win_free(&mailboxWindows[border]);
+    }
+    MPI_Comm_free(&nodeCommunicator);
+#endif
+    for (int border = 0; border < 4; border++) {
+        if (sendRequests[border] != MPI_REQUEST_NULL)
+            MPI_Request_free(&sendRequests[border]);
+        if (receiveRequests[border] != MPI_REQUEST_NULL)
+            MPI_Request_free(&receiveRequests[border]);
+    }
+
+#if defined(NEIGHBOURHOOD_COLLECTIVES) && !defined(INTERLEAVED_STATE)
+    for (int border = 0; border < 4; border++) {
+        if (boundaryType[border] == CONNECT) {
+            MPI_Type_free(&neighbourSendType[border]);
+            MPI_Type_free(&neighbourReceiveType[border]);
+        }
+    }
+#endif
+
+#if defined(INTERLEAVED_STATE)
+    for (int border = 0; border < 4; border++) {
+        MPI_Type_free(&sendLayer[border]);
+        MPI_Type_free(&receiveLayer[border]);
+    }
+    MPI_Type_free(&CELL_COLUMN);
+    MPI_Type_free(&CELL_ROW);
+#else
     MPI_Type_free(&HORIZONTAL_BOUNDARY);
+#endif
 }
 
-void SWE_DimensionalSplittingMpi::connectNeighbours(int p_neighbourRankId[]) {
-    for (int i = 0; i < 4; i++) {
-        neighbourRankId[i] = p_neighbourRankId[i];
+#if !defined(INTERLEAVED_STATE)
+/**
+ * First cell, count and datatype of the cells of the layer at border,
+ * the inner layer sent to the neighbour or the ghost layer received from it.
+ */
+void SWE_DimensionalSplittingMpi::getLayerCells(Boundary border, bool ghost, int &i, int &j, int &count,
+                                                MPI_Datatype &type) {
+    switch (border) {
+        case BND_LEFT:
+            i = ghost ? 0 : 1;
+            j = 1;
+            count = ny;
+            type = MPI_STATE_TYPE;
+            break;
+        case BND_RIGHT:
+            i = ghost ? nx + 1 : nx;
+            j = 1;
+            count = ny;
+            type = MPI_STATE_TYPE;
+            break;
+        case BND_BOTTOM:
+            i = 1;
+            j = ghost ? 0 : 1;
+            count = 1;
+            type = HORIZONTAL_BOUNDARY;
+            break;
+        case BND_TOP:
+            i = 1;
+            j = ghost ? ny + 1 : ny;
+            count = 1;
+            type = HORIZONTAL_BOUNDARY;
+            break;
     }
 }
 
-void SWE_DimensionalSplittingMpi::exchangeBathymetry() {
+/**
+ * Packs the timestep and h, hu, hv of the layer sent to the neighbour at border into its send buffer.
+ */
+void SWE_DimensionalSplittingMpi::packGhostLayer(Boundary border, TimeScalar timestep) {
+    int i, j, count;
+    MPI_Datatype type;
+    getLayerCells(border, false, i, j, count, type);
+
+    char *buffer = sendBuffer[border].data();
+    const int size = sendBuffer[border].size();
+    int position = 0;
+    MPI_Pack(&timestep, 1, MPI_TIME_TYPE, buffer, size, &position, communicator);
+    MPI_Pack(&h[i][j], count, type, buffer, size, &position, communicator);
+    MPI_Pack(&hu[i][j], count, type, buffer, size, &position, communicator);
+    MPI_Pack(&hv[i][j], count, type, buffer, size, &position, communicator);
+}
 
-    /*********
-     * SEND *
-     ********/
+/**
+ * Unpacks the message received from the neighbour at border into its timestep and the ghost layer of the buffers.
+ */
+void SWE_DimensionalSplittingMpi::unpackGhostLayer(Boundary border) {
+    int i, j, count;
+    MPI_Datatype type;
+    getLayerCells(border, true, i, j, count, type);
+
+    char *buffer = receiveBuffer[border].data();
+    const int size = receiveBuffer[border].size();
+    int position = 0;
+    MPI_Unpack(buffer, size, &position, &borderTimestep[border], 1, MPI_TIME_TYPE, communicator);
+    MPI_Unpack(buffer, size, &position, &bufferH[i][j], count, type, communicator);
+    MPI_Unpack(buffer, size, &position, &bufferHu[i][j], count, type, communicator);
+    MPI_Unpack(buffer, size, &position, &bufferHv[i][j], count, type, communicator);
+}
 
-    // The requests generated by the Isends are immediately freed, since we will wait on the requests generated by the corresponding receives
-    MPI_Request req;
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+/**
+ * Datatype of the ghost layer message at border for the neighbourhood collective:
+ * the timestep followed by h, hu and hv of the layer, at absolute addresses like the packed message.
+ *
+ * @param ghost the ghost layer received from the neighbour instead of the layer sent to it
+ */
+MPI_Datatype SWE_DimensionalSplittingMpi::createNeighbourLayerType(Boundary border, bool ghost) {
+    int i, j, count;
+    MPI_Datatype type;
+    getLayerCells(border, ghost, i, j, count, type);
+
+    int blockLengths[4] = {1, count, count, count};
+    MPI_Aint displacements[4];
+    MPI_Datatype types[4] = {MPI_TIME_TYPE, type, type, type};
+    MPI_Get_address(ghost ? &borderTimestep[border] : &sentTimestep, &displacements[0]);
+    MPI_Get_address(ghost ? &bufferH[i][j] : &h[i][j], &displacements[1]);
+    MPI_Get_address(ghost ? &bufferHu[i][j] : &hu[i][j], &displacements[2]);
+    MPI_Get_address(ghost ? &bufferHv[i][j] : &hv[i][j], &displacements[3]);
+
+    MPI_Datatype layerType;
+    MPI_Type_create_struct(4, blockLengths, displacements, types, &layerType);
+    MPI_Type_commit(&layerType);
+    return layerType;
+}
+#endif // NEIGHBOURHOOD_COLLECTIVES
+#endif
 
-    if (boundaryType[BND_LEFT] == CONNECT) {
-        int startIndex = ny + 2 + 1;
-        MPI_Isend(b.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_B_LEFT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
-    }
-    if (boundaryType[BND_RIGHT] == CONNECT) {
-        int startIndex = nx * (ny + 2) + 1;
-        MPI_Isend(b.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_B_RIGHT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+#if defined(INTERLEAVED_STATE)
+/**
+ * Datatype of a ghost layer message: the timestep followed by the boundary cells starting at cells.
+ */
+MPI_Datatype SWE_DimensionalSplittingMpi::createLayerType(TimeScalar *timestep, void *cells, MPI_Datatype cellType) {
+    int blockLengths[2] = {1, 1};
+    MPI_Aint displacements[2];
+    MPI_Datatype types[2] = {MPI_TIME_TYPE, cellType};
+    MPI_Get_address(timestep, &displacements[0]);
+    MPI_Get_address(cells, &displacements[1]);
+
+    MPI_Datatype layerType;
+    MPI_Type_create_struct(2, blockLengths, displacements, types, &layerType);
+    MPI_Type_commit(&layerType);
+    return layerType;
+}
+#endif
+
+void SWE_DimensionalSplittingMpi::connectNeighbours(int p_neighbourRankId[]) {
+    for (int i = 0; i < 4; i++) {
+        neighbourRankId[i] = p_neighbourRankId[i];
     }
-    if (boundaryType[BND_BOTTOM] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Isend(&b[i][1], 1, MPI_FLOAT, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_B_BOTTOM, MPI_COMM_WORLD, &req);
-            MPI_Request_free(&req);
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+    connectSharedNeighbours();
+#endif
+
+    /*
+     * Buffers, counts, neighbours and tags of the ghost layer messages never change,
+     * so the exchange uses persistent requests which are created once and started in every setGhostLayer().
+     * Has to be called after the boundary types have been set by initScenario().
+     */
+    const int sendTags[4] = {MPI_TAG_OUT_H_LEFT, MPI_TAG_OUT_H_RIGHT, MPI_TAG_OUT_H_BOTTOM, MPI_TAG_OUT_H_TOP};
+    const int receiveTags[4] = {MPI_TAG_OUT_H_RIGHT, MPI_TAG_OUT_H_LEFT, MPI_TAG_OUT_H_TOP, MPI_TAG_OUT_H_BOTTOM};
+
+    for (int border = 0; border < 4; border++) {
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+        if (sharedNeighbour[border]) {
+            sendRequests[border] = MPI_REQUEST_NULL;
+            receiveRequests[border] = MPI_REQUEST_NULL;
+            continue;
         }
-    }
-    if (boundaryType[BND_TOP] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Isend(&b[i][ny], 1, MPI_FLOAT, neighbourRankId[BND_TOP], MPI_TAG_OUT_B_TOP, MPI_COMM_WORLD, &req);
-            MPI_Request_free(&req);
+#endif
+        if (boundaryType[border] != CONNECT) {
+            sendRequests[border] = MPI_REQUEST_NULL;
+            receiveRequests[border] = MPI_REQUEST_NULL;
+            continue;
         }
+#if defined(INTERLEAVED_STATE)
+        MPI_Send_init(MPI_BOTTOM, 1, sendLayer[border], neighbourRankId[border], sendTags[border], communicator,
+                      &sendRequests[border]);
+        MPI_Recv_init(MPI_BOTTOM, 1, receiveLayer[border], neighbourRankId[border], receiveTags[border],
+                      communicator, &receiveRequests[border]);
+#else
+        MPI_Send_init(sendBuffer[border].data(), sendBuffer[border].size(), MPI_PACKED, neighbourRankId[border],
+                      sendTags[border], communicator, &sendRequests[border]);
+        MPI_Recv_init(receiveBuffer[border].data(), receiveBuffer[border].size(), MPI_PACKED, neighbourRankId[border],
+                      receiveTags[border], communicator, &receiveRequests[border]);
+#endif
     }
 
-    /***********
-     * RECEIVE *
-     **********/
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+    /*
+     * On a Cartesian communicator, the neighbours of the collective are ordered like Boundary:
+     * left and right (dimension 0), bottom and top (dimension 1), MPI_PROC_NULL at the domain boundary.
+     * With local timestepping the neighbours exchange different subsets of the borders in each step,
+     * so the point-to-point requests are used.
+     */
+    int topology;
+    MPI_Topo_test(communicator, &topology);
+    useNeighbourCollective = topology == MPI_CART && !localTimestepping;
+
+    for (int border = 0; border < 4; border++) {
+        neighbourDisplacements[border] = 0;
+        if (boundaryType[border] != CONNECT) {
+            neighbourSendType[border] = neighbourReceiveType[border] = MPI_BYTE;
+            continue;
+        }
+#if defined(INTERLEAVED_STATE)
+        neighbourSendType[border] = sendLayer[border];
+        neighbourReceiveType[border] = receiveLayer[border];
+#else
+        neighbourSendType[border] = createNeighbourLayerType(static_cast<Boundary>(border), false);
+        neighbourReceiveType[border] = createNeighbourLayerType(static_cast<Boundary>(border), true);
+#endif
+    }
+#endif // NEIGHBOURHOOD_COLLECTIVES
+}
 
-    MPI_Request recvReqs[4];
-    MPI_Status stati[4];
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+/**
+ * Finds the neighbours on the same node and sets up the mailboxes of the ghost layers exchanged with them.
+ * Collective on the node, neighbours on other nodes keep the messages.
+ */
+void SWE_DimensionalSplittingMpi::connectSharedNeighbours() {
+    MPI_Comm_split_type(communicator, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodeCommunicator);
+
+    MPI_Group group;
+    MPI_Group nodeGroup;
+    MPI_Comm_group(communicator, &group);
+    MPI_Comm_group(nodeCommunicator, &nodeGroup);
+
+    int nodeRank[4];
+    for (int border = 0; border < 4; border++) {
+        nodeRank[border] = MPI_UNDEFINED;
+        if (boundaryType[border] == CONNECT)
+            MPI_Group_translate_ranks(group, 1, &neighbourRankId[border], nodeGroup, &nodeRank[border]);
+        sharedNeighbour[border] = nodeRank[border] != MPI_UNDEFINED;
+    }
+    MPI_Group_free(&group);
+    MPI_Group_free(&nodeGroup);
+
+    // The receiver allocates the mailbox of each ghost layer
+    for (int border = 0; border < 4; border++) {
+        const int count = (border == BND_LEFT || border == BND_RIGHT) ? ny : nx;
+        const MPI_Aint size = sharedNeighbour[border] ? SharedMailbox<StateScalar>::size(count) : 0;
+
+        void *memory;
+        MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, nodeCommunicator, &memory, &mailboxWindows[border]);
+        if (sharedNeighbour[border]) {
+            receiveMailbox[border] = SharedMailbox<StateScalar>(memory, count);
+            receiveMailbox[border].initialize();
+        }
+    }
+    MPI_Barrier(nodeCommunicator);
+
+    // The neighbour at the left border receives in its right mailbox and so on
+    const Boundary opposite[4] = {BND_RIGHT, BND_LEFT, BND_TOP, BND_BOTTOM};
+    for (int border = 0; border < 4; border++) {
+        if (!sharedNeighbour[border])
+            continue;
+
+        const int count = (border == BND_LEFT || border == BND_RIGHT) ? ny : nx;
+        MPI_Aint size;
+        int displacementUnit;
+        void *memory;
+        MPI_Win_shared_query(mailboxWindows[opposite[border]], nodeRank[border], &size, &displacementUnit, &memory);
+        // The neighbour aligns its mailbox within the same padding
+        assert(size == (MPI_Aint) SharedMailbox<StateScalar>::size(count));
+        sendMailbox[border] = SharedMailbox<StateScalar>(memory, count);
+    }
+}
 
-    if (boundaryType[BND_LEFT] == CONNECT) {
-        int startIndex = 1;
-        MPI_Irecv(b.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_B_RIGHT,
-                  MPI_COMM_WORLD, &recvReqs[BND_LEFT]);
-    } else {
-        recvReqs[BND_LEFT] = MPI_REQUEST_NULL;
+/**
+ * Copies the timestep and h, hu, hv of the layer at border into the mailbox of the neighbour.
+ */
+void SWE_DimensionalSplittingMpi::writeSharedLayer(Boundary border) {
+    int i, j, di, dj, count;
+    getLayerRange(border, false, i, j, di, dj, count);
+
+    const long exchange = ++sentExchanges[border];
+    StateScalar *cells = sendMailbox[border].beginWrite(exchange);
+    for (int k = 0; k < count; k++, i += di, j += dj) {
+        cells[k] = h[i][j];
+        cells[count + k] = hu[i][j];
+        cells[2 * count + k] = hv[i][j];
     }
+    sendMailbox[border].endWrite(exchange, sentTimestep);
+}
 
-    if (boundaryType[BND_RIGHT] == CONNECT) {
-        int startIndex = (nx + 1) * (ny + 2) + 1;
-        MPI_Irecv(b.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_B_LEFT,
-                  MPI_COMM_WORLD, &recvReqs[BND_RIGHT]);
-    } else {
-        recvReqs[BND_RIGHT] = MPI_REQUEST_NULL;
+/**
+ * Waits for the layer of the neighbour at border and copies it into the ghost layer.
+ */
+void SWE_DimensionalSplittingMpi::readSharedLayer(Boundary border) {
+    int i, j, di, dj, count;
+    getLayerRange(border, true, i, j, di, dj, count);
+
+    const long exchange = ++receivedExchanges[border];
+    const StateScalar *cells = receiveMailbox[border].beginRead(exchange, borderTimestep[border]);
+    for (int k = 0; k < count; k++, i += di, j += dj) {
+        bufferH[i][j] = cells[k];
+        bufferHu[i][j] = cells[count + k];
+        bufferHv[i][j] = cells[2 * count + k];
     }
+    receiveMailbox[border].endRead(exchange);
+}
+#endif // SHARED_MEMORY_NEIGHBOURS
 
-    if (boundaryType[BND_BOTTOM] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Irecv(&b[i][0], 1, MPI_FLOAT, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_B_TOP, MPI_COMM_WORLD,
-                      &recvReqs[BND_BOTTOM]);
-        }
-    } else {
-        recvReqs[BND_BOTTOM] = MPI_REQUEST_NULL;
+/**
+ * First cell, step to the next cell and number of cells of the layer at border,
+ * the inner layer sent to the neighbour or the ghost layer received from it.
+ */
+void SWE_DimensionalSplittingMpi::getLayerRange(Boundary border, bool ghost, int &i, int &j, int &di, int &dj,
+                                                int &count) {
+    switch (border) {
+        case BND_LEFT:
+            i = ghost ? 0 : 1;
+            j = 1;
+            di = 0;
+            dj = 1;
+            count = ny;
+            break;
+        case BND_RIGHT:
+            i = ghost ? nx + 1 : nx;
+            j = 1;
+            di = 0;
+            dj = 1;
+            count = ny;
+            break;
+        case BND_BOTTOM:
+            i = 1;
+            j = ghost ? 0 : 1;
+            di = 1;
+            dj = 0;
+            count = nx;
+            break;
+        case BND_TOP:
+            i = 1;
+            j = ghost ? ny + 1 : ny;
+            di = 1;
+            dj = 0;
+            count = nx;
+            break;
     }
+}
 
-    if (boundaryType[BND_TOP] == CONNECT) {
-        for (int i = 1; i < nx + 1; i++) {
-            MPI_Irecv(&b[i][ny + 1], 1, MPI_FLOAT, neighbourRankId[BND_TOP], MPI_TAG_OUT_B_BOTTOM, MPI_COMM_WORLD,
-                      &recvReqs[BND_TOP]);
+/**
+ * Datatype of the static fields of the layer at border, at absolute addresses.
+ * b is the only static field of the cells, further ones (e.g. friction) would be added to the struct.
+ */
+MPI_Datatype SWE_DimensionalSplittingMpi::createStaticLayerType(Boundary border, bool ghost) {
+    int i, j, di, dj, count;
+    getLayerRange(border, ghost, i, j, di, dj, count);
+
+    // The distance of two cells of the layer covers all layouts of the arrays
+    MPI_Aint first, next;
+    MPI_Get_address(&b[i][j], &first);
+    MPI_Get_address(&b[i + di][j + dj], &next);
+    MPI_Datatype bathymetry;
+    MPI_Type_create_hvector(count, 1, next - first, MPI_STATE_TYPE, &bathymetry);
+
+    int blockLengths[1] = {1};
+    MPI_Aint displacements[1] = {first};
+    MPI_Datatype types[1] = {bathymetry};
+    MPI_Datatype layerType;
+    MPI_Type_create_struct(1, blockLengths, displacements, types, &layerType);
+    MPI_Type_commit(&layerType);
+    MPI_Type_free(&bathymetry);
+    return layerType;
+}
+
+/**
+ * Exchanges the static fields of the boundary cells with the neighbours, one message per neighbour.
+ */
+void SWE_DimensionalSplittingMpi::exchangeBathymetry() {
+    const int sendTags[4] = {MPI_TAG_OUT_B_LEFT, MPI_TAG_OUT_B_RIGHT, MPI_TAG_OUT_B_BOTTOM, MPI_TAG_OUT_B_TOP};
+    const int receiveTags[4] = {MPI_TAG_OUT_B_RIGHT, MPI_TAG_OUT_B_LEFT, MPI_TAG_OUT_B_TOP, MPI_TAG_OUT_B_BOTTOM};
+
+    MPI_Request requests[8];
+    MPI_Datatype layerTypes[8];
+    for (int border = 0; border < 4; border++) {
+        if (boundaryType[border] != CONNECT) {
+            requests[border] = requests[4 + border] = MPI_REQUEST_NULL;
+            layerTypes[border] = layerTypes[4 + border] = MPI_DATATYPE_NULL;
+            continue;
         }
-    } else {
-        recvReqs[BND_TOP] = MPI_REQUEST_NULL;
-    }
 
-    MPI_Waitall(4, recvReqs, stati);
+        layerTypes[border] = createStaticLayerType(static_cast<Boundary>(border), true);
+        layerTypes[4 + border] = createStaticLayerType(static_cast<Boundary>(border), false);
+        MPI_Irecv(MPI_BOTTOM, 1, layerTypes[border], neighbourRankId[border], receiveTags[border], communicator,
+                  &requests[border]);
+        MPI_Isend(MPI_BOTTOM, 1, layerTypes[4 + border], neighbourRankId[border], sendTags[border], communicator,
+                  &requests[4 + border]);
+    }
 
+    MPI_Waitall(8, requests, MPI_STATUSES_IGNORE);
+    for (int k = 0; k < 8; k++) {
+        if (layerTypes[k] != MPI_DATATYPE_NULL)
+            MPI_Type_free(&layerTypes[k]);
+    }
 }
 
 void SWE_DimensionalSplittingMpi::setGhostLayer() {
+    startGhostLayerExchange();
+    finishGhostLayerExchange();
+}
+
+/**
+ * Applies the boundary conditions and starts the sends and receives of the ghost layers.
+ */
+void SWE_DimensionalSplittingMpi::startGhostLayerExchange() {
     // Apply appropriate conditions for OUTFLOW/WALL boundaries
     SWE_Block::applyBoundaryConditions();
 
-    MPI_Status status;
-
     assert(h.getRows() == ny + 2);
     assert(hu.getRows() == ny + 2);
     assert(hv.getRows() == ny + 2);
@@ -203,177 +604,459 @@ void SWE_DimensionalSplittingMpi::setGhostLayer() {
      * SEND *
      ********/
     CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_EXCHANGE);
-    // The requests generated by the Isends are immediately freed, since we will wait on the requests generated by the corresponding receives
-    MPI_Request req;
-
-    float totalLocalTimestep = getTotalLocalTimestep();
-
-    if (boundaryType[BND_LEFT] == CONNECT && isSendable(BND_LEFT)) {
-        int startIndex = ny + 2 + 1;
+    // One message per boundary: the timestep and h, hu, hv of the boundary cells, see connectNeighbours().
+    // The sends are completed at the end of the exchange, so the layers can be packed again in the next one.
+    // The layers are sent directly from the cells with INTERLEAVED_STATE and the neighbourhood collective,
+    // see createLayerType() and createNeighbourLayerType()
+    sentTimestep = getTotalLocalTimestep();
+
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+    if (useNeighbourCollective) {
+        for (int border = 0; border < 4; border++) {
+            const bool connected = boundaryType[border] == CONNECT;
+            neighbourSendCounts[border] = connected && isSendable(static_cast<Boundary>(border)) ? 1 : 0;
+            neighbourReceiveCounts[border] = connected && isReceivable(static_cast<Boundary>(border)) ? 1 : 0;
+        }
+        MPI_Ineighbor_alltoallw(MPI_BOTTOM, neighbourSendCounts, neighbourDisplacements, neighbourSendType,
+                                MPI_BOTTOM, neighbourReceiveCounts, neighbourDisplacements, neighbourReceiveType,
+                                communicator, &neighbourExchange);
+    } else
+#endif // NEIGHBOURHOOD_COLLECTIVES
+    {
+        for (int border = 0; border < 4; border++) {
+            if (boundaryType[border] == CONNECT && isSendable(static_cast<Boundary>(border))) {
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+                if (sharedNeighbour[border]) {
+                    writeSharedLayer(static_cast<Boundary>(border));
+                    continue;
+                }
+#endif
+#if !defined(INTERLEAVED_STATE)
+                packGhostLayer(static_cast<Boundary>(border), sentTimestep);
+#endif
+                MPI_Start(&sendRequests[border]);
+            }
+        }
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_TIMESTEP_LEFT, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+        /***********
+         * RECEIVE *
+         **********/
+
+        for (int border = 0; border < 4; border++) {
+            receivingGhostLayer[border] = boundaryType[border] == CONNECT && isReceivable(static_cast<Boundary>(border));
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+            // Read in finishGhostLayerExchange()
+            receivingSharedLayer[border] = receivingGhostLayer[border] && sharedNeighbour[border];
+            receivingGhostLayer[border] = receivingGhostLayer[border] && !sharedNeighbour[border];
+#endif
+            if (receivingGhostLayer[border])
+                MPI_Start(&receiveRequests[border]);
+        }
+    }
 
-        MPI_Isend(h.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_H_LEFT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+    CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_EXCHANGE);
+#if defined(OVERLAP_EXCHANGE)
+    exchangeInFlight = true;
+    receivesPending = true;
+#endif
+}
 
-        MPI_Isend(hu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_HU_LEFT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+/**
+ * Waits for the ghost layers started by startGhostLayerExchange() and checks which borders are in sync.
+ */
+void SWE_DimensionalSplittingMpi::finishGhostLayerExchange() {
+    CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_EXCHANGE);
 
-        MPI_Isend(hv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_HV_LEFT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+    if (useNeighbourCollective) {
+        MPI_Wait(&neighbourExchange, MPI_STATUS_IGNORE);
+    } else
+#endif // NEIGHBOURHOOD_COLLECTIVES
+    {
+        // Requests which have not been started are inactive and complete immediately
+        MPI_Waitall(4, receiveRequests, MPI_STATUSES_IGNORE);
+#if !defined(INTERLEAVED_STATE)
+        for (int border = 0; border < 4; border++) {
+            if (receivingGhostLayer[border])
+                unpackGhostLayer(static_cast<Boundary>(border));
+        }
+#endif
+        MPI_Waitall(4, sendRequests, MPI_STATUSES_IGNORE);
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+        for (int border = 0; border < 4; border++) {
+            if (receivingSharedLayer[border])
+                readSharedLayer(static_cast<Boundary>(border));
+        }
+#endif
     }
-    if (boundaryType[BND_RIGHT] == CONNECT && isSendable(BND_RIGHT)) {
-        int startIndex = nx * (ny + 2) + 1;
+    //std::cout << myMpiRank << " | " << iteration << " | "<< borderTimestep[0] << " " << borderTimestep[1] << " " << borderTimestep[2] << " " << borderTimestep[3] << "\n";
+    checkAllGhostlayers();
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_TIMESTEP_RIGHT, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
 
-        MPI_Isend(h.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_H_RIGHT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+    CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_EXCHANGE);
+#if defined(OVERLAP_EXCHANGE)
+    exchangeInFlight = false;
+    receivesPending = false;
+#endif
+
+    iteration++;
+}
 
-        MPI_Isend(hu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HU_RIGHT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+void SWE_DimensionalSplittingMpi::setProgressInterval(int columns) {
+    progressInterval = columns;
+}
 
-        MPI_Isend(hv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HV_RIGHT,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+/**
+ * Lets MPI progress the ghost layer exchange and the timestep reduction in flight.
+ * MPI only moves non-blocking messages while the process is inside the library,
+ * so the kernels call this every progressInterval columns (see progressBetweenColumns()).
+ */
+void SWE_DimensionalSplittingMpi::progressCommunication() {
+#if defined(OVERLAP_EXCHANGE)
+    testGhostLayerExchange();
+    if (exchangeInFlight) {
+        // Completed sends become inactive, finishGhostLayerExchange() does not wait for them anymore
+        int sent;
+        MPI_Testall(4, sendRequests, &sent, MPI_STATUSES_IGNORE);
     }
-    if (boundaryType[BND_BOTTOM] == CONNECT && isSendable(BND_BOTTOM)) {
-
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourRankId[BND_BOTTOM], MPI_TAG_TIMESTEP_BOTTOM,
-                  MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+#endif // OVERLAP_EXCHANGE
+#if defined(NONBLOCKING_REDUCTION) || defined(LAGGED_TIMESTEP)
+    // Does not free the request, the reduction is still completed by MPI_Wait
+    if (timestepReduction != MPI_REQUEST_NULL) {
+        int reduced;
+        MPI_Request_get_status(timestepReduction, &reduced, MPI_STATUS_IGNORE);
+    }
+#endif
+}
+#endif // ASYNCHRONOUS_COMMUNICATION
 
-        MPI_Isend(&h[1][1], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_H_BOTTOM, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+#if defined(OVERLAP_EXCHANGE)
+/**
+ * Checks whether the ghost layers have arrived, called between the columns of the interior edges.
+ * Besides measuring the hidden exchange time, this lets MPI progress the messages during the computation.
+ */
+void SWE_DimensionalSplittingMpi::testGhostLayerExchange() {
+    if (!receivesPending)
+        return;
+
+    int received;
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+    if (useNeighbourCollective)
+        MPI_Test(&neighbourExchange, &received, MPI_STATUS_IGNORE);
+    else
+#endif // NEIGHBOURHOOD_COLLECTIVES
+        MPI_Testall(4, receiveRequests, &received, MPI_STATUSES_IGNORE);
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+    for (int border = 0; border < 4; border++) {
+        if (receivingSharedLayer[border])
+            received = received && receiveMailbox[border].isReady(receivedExchanges[border] + 1);
+    }
+#endif
+    if (received) {
+        CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_HIDDEN_EXCHANGE);
+        receivesPending = false;
+    }
+}
 
-        MPI_Isend(&hu[1][1], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_HU_BOTTOM, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+/**
+ * Computes the net updates of all edges between two cells of the block, which do not depend on the ghost layer.
+ * The exchange started by startGhostLayerExchange() is in flight meanwhile.
+ *
+ * @return maximum wave speed of the edges
+ */
+float SWE_DimensionalSplittingMpi::computeInteriorNetUpdates() {
+    float maxWaveSpeed = (float) 0.;
+    if (receivesPending)
+        CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_HIDDEN_EXCHANGE);
+
+#if defined(HYBRID_THREADING)
+#pragma omp parallel for reduction(max : maxWaveSpeed) schedule(static)
+#endif // HYBRID_THREADING
+    for (int i = 2; i < nx + 1; i++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeVerticalEdges(i, 1, ny + 1));
+        progressBetweenColumns(i);
+    }
+    if (ny > 1) {
+#if defined(HYBRID_THREADING)
+#pragma omp parallel for reduction(max : maxWaveSpeed) schedule(static)
+#endif // HYBRID_THREADING
+        for (int i = 1; i < nx + 1; i++) {
+            maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, 2, ny + 1));
+            progressBetweenColumns(i);
+        }
+    }
 
-        MPI_Isend(&hv[1][1], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_HV_BOTTOM, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+    // The ghost layers are still in flight, the whole computation was hidden
+    if (receivesPending) {
+        CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_HIDDEN_EXCHANGE);
+        receivesPending = false;
+    }
+    return maxWaveSpeed;
+}
 
+/**
+ * Computes the net updates of the edges next to the ghost layer: the left- and right-most vertical edges
+ * and the lowest and highest horizontal edge of each column.
+ *
+ * @return maximum wave speed of the edges
+ */
+float SWE_DimensionalSplittingMpi::computeBoundaryNetUpdates() {
+    float maxWaveSpeed = std::max(computeVerticalEdges(1, 1, ny + 1), computeVerticalEdges(nx + 1, 1, ny + 1));
+
+#if defined(HYBRID_THREADING)
+#pragma omp parallel for reduction(max : maxWaveSpeed) schedule(static)
+#endif // HYBRID_THREADING
+    for (int i = 1; i < nx + 1; i++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, 1, 2));
+        maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, ny + 1, ny + 2));
     }
-    if (boundaryType[BND_TOP] == CONNECT && isSendable(BND_TOP)) {
+    return maxWaveSpeed;
+}
+#endif // OVERLAP_EXCHANGE
 
-        MPI_Isend(&totalLocalTimestep, 1, MPI_FLOAT, neighbourRankId[BND_TOP], MPI_TAG_TIMESTEP_TOP, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+#if defined(FUSED_KERNEL)
+/**
+ * Cheap pre-pass of the fused kernel.
+ * The HLLE wave speeds of an edge are bounded by |u| + sqrt(g * h) of its two adjacent cells
+ * (the Roe averages are convex combinations of the cell values), so the maximum over all cells,
+ * including the ghost layer, yields a safe timestep without solving any Riemann problem.
+ * The resulting timestep is at most as large as the one of the unfused kernel.
+ *
+ * @return upper bound of the maximum edge wave speed
+ */
+float SWE_DimensionalSplittingMpi::computeMaxCellWaveSpeed() {
+    float maxWaveSpeed = (float) 0.;
 
-        MPI_Isend(&h[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_TOP], MPI_TAG_OUT_H_TOP, MPI_COMM_WORLD, &req);
-        MPI_Request_free(&req);
+    for (int i = 0; i < nx + 2; i++) {
+#if defined(VECTORIZE)
+#pragma omp simd reduction(max:maxWaveSpeed)
+#endif // VECTORIZE
+        for (int j = 0; j < ny + 2; j++) {
+            if (h[i][j] > 0) {
+                float momentum = std::max(std::abs(hu[i][j]), std::abs(hv[i][j]));
+                maxWaveSpeed = std::max(maxWaveSpeed, momentum / h[i][j] + std::sqrt(g * h[i][j]));
+            }
+        }
+    }
 
-        MPI_Isend(&hu[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_TOP], MPI_TAG_OUT_HU_TOP, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+    return maxWaveSpeed;
+}
+#endif // FUSED_KERNEL
 
-        MPI_Isend(&hv[1][ny], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_TOP], MPI_TAG_OUT_HV_TOP, MPI_COMM_WORLD,
-                  &req);
-        MPI_Request_free(&req);
+#if defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING) || defined(OVERLAP_EXCHANGE)
+/**
+ * Computes the net updates of the edges with row index jBegin <= j < jEnd
+ * between cell column i - 1 and i.
+ *
+ * @return maximum wave speed of the edges
+ */
+float SWE_DimensionalSplittingMpi::computeVerticalEdges(int i, int jBegin, int jEnd) {
+#if defined(BATCHED_SOLVER)
+    return batchSolver.computeNetUpdates (
+            jEnd - jBegin,
+            h[i - 1] + jBegin, h[i] + jBegin,
+            hu[i - 1] + jBegin, hu[i] + jBegin,
+            edgeBathymetry.vertical[i - 1] + jBegin - 1,
+            hNetUpdatesLeft[i - 1] + jBegin - 1, hNetUpdatesRight[i - 1] + jBegin - 1,
+            huNetUpdatesLeft[i - 1] + jBegin - 1, huNetUpdatesRight[i - 1] + jBegin - 1
+    );
+#else
+    float maxWaveSpeed = (float) 0.;
 
+#if defined(VECTORIZE)
+#pragma omp simd reduction(max:maxWaveSpeed)
+#endif // VECTORIZE
+    for (int j = jBegin; j < jEnd; j++) {
+        float maxEdgeSpeed;
+
+        solver.computeNetUpdates (
+                h[i - 1][j], h[i][j],
+                hu[i - 1][j], hu[i][j],
+                b[i - 1][j], b[i][j],
+                hNetUpdatesLeft[i - 1][j - 1], hNetUpdatesRight[i - 1][j - 1],
+                huNetUpdatesLeft[i - 1][j - 1], huNetUpdatesRight[i - 1][j - 1],
+                maxEdgeSpeed
+        );
+        maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
     }
 
-    /***********
-     * RECEIVE *
-     **********/
+    return maxWaveSpeed;
+#endif // BATCHED_SOLVER
+}
 
-    // 4 Boundaries times 3 arrays (h, hu, hv) means 12 requests
-    // The requests corresponding to the h array will be at indices 0, 3, 6, 9
-    // hu array requests will be at indices 1, 4, 5, 10 and so forth
-    MPI_Request recvReqs[16];
-    MPI_Status stati[16];
+/**
+ * Computes the net updates of the edges between cell row j - 1 and j, jBegin <= j < jEnd,
+ * in cell column i.
+ *
+ * @return maximum wave speed of the edges
+ */
+float SWE_DimensionalSplittingMpi::computeHorizontalEdges(int i, int jBegin, int jEnd) {
+#if defined(BATCHED_SOLVER)
+    return batchSolver.computeNetUpdates (
+            jEnd - jBegin,
+            h[i] + jBegin - 1, h[i] + jBegin,
+            hv[i] + jBegin - 1, hv[i] + jBegin,
+            edgeBathymetry.horizontal[i - 1] + jBegin - 1,
+            hNetUpdatesBelow[i - 1] + jBegin - 1, hNetUpdatesAbove[i - 1] + jBegin - 1,
+            hvNetUpdatesBelow[i - 1] + jBegin - 1, hvNetUpdatesAbove[i - 1] + jBegin - 1
+    );
+#else
+    float maxWaveSpeed = (float) 0.;
 
-    if (boundaryType[BND_LEFT] == CONNECT && isReceivable(BND_LEFT)) {
-        int startIndex = 1;
-        MPI_Irecv(bufferH.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_H_RIGHT,
-                  MPI_COMM_WORLD, &recvReqs[0]);
-        MPI_Irecv(bufferHu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_HU_RIGHT,
-                  MPI_COMM_WORLD, &recvReqs[1]);
-        MPI_Irecv(bufferHv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_OUT_HV_RIGHT,
-                  MPI_COMM_WORLD, &recvReqs[2]);
-        MPI_Irecv(&borderTimestep[BND_LEFT], 1, MPI_FLOAT, neighbourRankId[BND_LEFT], MPI_TAG_TIMESTEP_RIGHT,
-                  MPI_COMM_WORLD, &recvReqs[3]);
-    } else {
-        recvReqs[0] = MPI_REQUEST_NULL;
-        recvReqs[1] = MPI_REQUEST_NULL;
-        recvReqs[2] = MPI_REQUEST_NULL;
-        recvReqs[3] = MPI_REQUEST_NULL;
-    }
-
-    if (boundaryType[BND_RIGHT] == CONNECT && isReceivable(BND_RIGHT)) {
-        int startIndex = (nx + 1) * (ny + 2) + 1;
-        MPI_Irecv(bufferH.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_H_LEFT,
-                  MPI_COMM_WORLD, &recvReqs[4]);
-        MPI_Irecv(bufferHu.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HU_LEFT,
-                  MPI_COMM_WORLD, &recvReqs[5]);
-        MPI_Irecv(bufferHv.getRawPointer() + startIndex, ny, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_OUT_HV_LEFT,
-                  MPI_COMM_WORLD, &recvReqs[6]);
-        MPI_Irecv(&borderTimestep[BND_RIGHT], 1, MPI_FLOAT, neighbourRankId[BND_RIGHT], MPI_TAG_TIMESTEP_LEFT,
-                  MPI_COMM_WORLD, &recvReqs[7]);
-    } else {
-        recvReqs[4] = MPI_REQUEST_NULL;
-        recvReqs[5] = MPI_REQUEST_NULL;
-        recvReqs[6] = MPI_REQUEST_NULL;
-        recvReqs[7] = MPI_REQUEST_NULL;
+#if defined(VECTORIZE)
+#pragma omp simd reduction(max:maxWaveSpeed)
+#endif // VECTORIZE
+    for (int j = jBegin; j < jEnd; j++) {
+        float maxEdgeSpeed;
+
+        solver.computeNetUpdates (
+                h[i][j - 1], h[i][j],
+                hv[i][j - 1], hv[i][j],
+                b[i][j - 1], b[i][j],
+                hNetUpdatesBelow[i - 1][j - 1], hNetUpdatesAbove[i - 1][j - 1],
+                hvNetUpdatesBelow[i - 1][j - 1], hvNetUpdatesAbove[i - 1][j - 1],
+                maxEdgeSpeed
+        );
+        maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
     }
 
-    if (boundaryType[BND_BOTTOM] == CONNECT && isReceivable(BND_BOTTOM)) {
-
-        MPI_Irecv(&bufferH[1][0], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_H_TOP,
-                  MPI_COMM_WORLD, &recvReqs[8]);
-        MPI_Irecv(&bufferHu[1][0], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_HU_TOP,
-                  MPI_COMM_WORLD, &recvReqs[9]);
-        MPI_Irecv(&bufferHv[1][0], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_BOTTOM], MPI_TAG_OUT_HV_TOP,
-                  MPI_COMM_WORLD, &recvReqs[10]);
-        MPI_Irecv(&borderTimestep[BND_BOTTOM], 1, MPI_FLOAT, neighbourRankId[BND_BOTTOM], MPI_TAG_TIMESTEP_TOP,
-                  MPI_COMM_WORLD, &recvReqs[11]);
+    return maxWaveSpeed;
+#endif // BATCHED_SOLVER
+}
 
-    } else {
-        recvReqs[8] = MPI_REQUEST_NULL;
-        recvReqs[9] = MPI_REQUEST_NULL;
-        recvReqs[10] = MPI_REQUEST_NULL;
-        recvReqs[11] = MPI_REQUEST_NULL;
+#if defined(DRY_TILE_SKIPPING)
+/**
+ * Computes the net updates of all edges adjacent to a cell of an active tile.
+ * Edges of skipped tiles lie between two dry cells at rest, they do not produce updates or wave speeds.
+ * An edge on the border between two active tiles is only computed by the right/upper tile.
+ *
+ * @param computedEdges is set to the number of edges that were solved
+ * @return maximum wave speed of the computed edges
+ */
+float SWE_DimensionalSplittingMpi::computeActiveTileNetUpdates(long &computedEdges) {
+    float maxWaveSpeed = (float) 0.;
+    computedEdges = 0;
+
+    // The ghost layer has just been set, so neighbouring blocks can activate the border tiles
+    tileActivity.updateActive(h, hu, hv);
+
+    const int tilesX = tileActivity.getTilesX();
+    const int tilesY = tileActivity.getTilesY();
+
+    for (int tileX = 0; tileX < tilesX; tileX++) {
+        for (int tileY = 0; tileY < tilesY; tileY++) {
+            if (!tileActivity.isActive(tileX, tileY))
+                continue;
+
+            const int iBegin = tileActivity.xBegin(tileX);
+            const int iEnd = tileActivity.xEnd(tileX);
+            const int jBegin = tileActivity.yBegin(tileY);
+            const int jEnd = tileActivity.yEnd(tileY);
+
+            // Right and upper border of the tile, unless the next tile computes them
+            const bool rightBorder = tileX + 1 == tilesX || !tileActivity.isActive(tileX + 1, tileY);
+            const bool upperBorder = tileY + 1 == tilesY || !tileActivity.isActive(tileX, tileY + 1);
+            const int iVerticalEnd = rightBorder ? iEnd + 1 : iEnd;
+            const int jHorizontalEnd = upperBorder ? jEnd + 1 : jEnd;
+
+            for (int i = iBegin; i < iVerticalEnd; i++) {
+                maxWaveSpeed = std::max(maxWaveSpeed, computeVerticalEdges(i, jBegin, jEnd));
+            }
+            for (int i = iBegin; i < iEnd; i++) {
+                maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, jBegin, jHorizontalEnd));
+            }
+
+            computedEdges += (iVerticalEnd - iBegin) * (jEnd - jBegin) + (iEnd - iBegin) * (jHorizontalEnd - jBegin);
+        }
     }
 
-    if (boundaryType[BND_TOP] == CONNECT && isReceivable(BND_TOP)) {
-
-        MPI_Irecv(&bufferH[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_TOP], MPI_TAG_OUT_H_BOTTOM,
-                  MPI_COMM_WORLD, &recvReqs[12]);
-        MPI_Irecv(&bufferHu[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_TOP], MPI_TAG_OUT_HU_BOTTOM,
-                  MPI_COMM_WORLD, &recvReqs[13]);
-        MPI_Irecv(&bufferHv[1][ny + 1], 1, HORIZONTAL_BOUNDARY, neighbourRankId[BND_TOP], MPI_TAG_OUT_HV_BOTTOM,
-                  MPI_COMM_WORLD, &recvReqs[14]);
-        MPI_Irecv(&borderTimestep[BND_TOP], 1, MPI_FLOAT, neighbourRankId[BND_TOP], MPI_TAG_TIMESTEP_BOTTOM,
-                  MPI_COMM_WORLD, &recvReqs[15]);
+    return maxWaveSpeed;
+}
+#endif // DRY_TILE_SKIPPING
 
-    } else {
-        recvReqs[12] = MPI_REQUEST_NULL;
-        recvReqs[13] = MPI_REQUEST_NULL;
-        recvReqs[14] = MPI_REQUEST_NULL;
-        recvReqs[15] = MPI_REQUEST_NULL;
+#if defined(WAVEFRONT_TRACKING)
+/**
+ * Computes the net updates of all edges adjacent to a cell inside the wavefront box.
+ * The edges outside of the box are still in their initial state and produce zero net updates,
+ * their wave speeds are bounded by WavefrontBox::getOutsideWaveSpeed().
+ *
+ * @param computedEdges is set to the number of edges that were solved
+ * @return maximum wave speed of all edges
+ */
+float SWE_DimensionalSplittingMpi::computeWavefrontNetUpdates(long &computedEdges) {
+    // The ghost layer has just been set, so changes of neighbouring blocks are added to the box
+    wavefrontBox.checkGhostLayer(h, hu, hv);
+
+    const int iBegin = wavefrontBox.getIBegin();
+    const int iEnd = wavefrontBox.getIEnd();
+    const int jBegin = wavefrontBox.getJBegin();
+    const int jEnd = wavefrontBox.getJEnd();
+
+    float maxWaveSpeed = wavefrontBox.getOutsideWaveSpeed();
+    computedEdges = 0;
+    if (iBegin >= iEnd || jBegin >= jEnd)
+        return maxWaveSpeed;
+
+    for (int i = iBegin; i < iEnd + 1; i++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeVerticalEdges(i, jBegin, jEnd));
+    }
+    for (int i = iBegin; i < iEnd; i++) {
+        maxWaveSpeed = std::max(maxWaveSpeed, computeHorizontalEdges(i, jBegin, jEnd + 1));
     }
 
+    computedEdges = (long) (iEnd - iBegin + 1) * (jEnd - jBegin) + (long) (iEnd - iBegin) * (jEnd - jBegin + 1);
+    return maxWaveSpeed;
+}
 
-    MPI_Waitall(16, recvReqs, stati);
-    //std::cout << myMpiRank << " | " << iteration << " | "<< borderTimestep[0] << " " << borderTimestep[1] << " " << borderTimestep[2] << " " << borderTimestep[3] << "\n";
-    checkAllGhostlayers();
+/**
+ * Marks the cells inside the wavefront box that received a non-zero net update from any of their edges
+ * and grows the box for the next timestep.
+ */
+void SWE_DimensionalSplittingMpi::trackWavefront() {
+    for (int i = wavefrontBox.getIBegin(); i < wavefrontBox.getIEnd(); i++) {
+        for (int j = wavefrontBox.getJBegin(); j < wavefrontBox.getJEnd(); j++) {
+            if (hNetUpdatesRight[i - 1][j - 1] != 0 || hNetUpdatesLeft[i][j - 1] != 0
+                || huNetUpdatesRight[i - 1][j - 1] != 0 || huNetUpdatesLeft[i][j - 1] != 0
+                || hNetUpdatesAbove[i - 1][j - 1] != 0 || hNetUpdatesBelow[i - 1][j] != 0
+                || hvNetUpdatesAbove[i - 1][j - 1] != 0 || hvNetUpdatesBelow[i - 1][j] != 0) {
+                wavefrontBox.markChanged(i, j);
+            }
+        }
+    }
 
+    wavefrontBox.advance(h, hu, hv, g);
+}
+#endif // WAVEFRONT_TRACKING
 
-    CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_EXCHANGE);
+/**
+ * Updates the cells iBegin <= i < iEnd, jBegin <= j < jEnd with the computed net-updates.
+ */
+void SWE_DimensionalSplittingMpi::updateCells(float dt, int iBegin, int iEnd, int jBegin, int jEnd) {
+    for (int i = iBegin; i < iEnd; i++) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = jBegin; j < jEnd; j++) {
+            h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
+            hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
+            hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
 
-    iteration++;
+            if (h[i][j] < 0) {
+#ifndef NDEBUG
+                if (h[i][j] < -0.1) {
+                    std::cerr << "Warning, negative height: (i,j)=(" << i << "," << j << ")=" << h[i][j] << std::endl;
+                    std::cerr << "         b: " << b[i][j] << std::endl;
+                }
+#endif // NDEBUG
+                //zero (small) negative depths
+                h[i][j] = hu[i][j] = hv[i][j] = 0.;
+            } else if (h[i][j] < 0.1)
+                hu[i][j] = hv[i][j] = 0.; //no water, no speed!
+        }
+    }
 }
+#endif // DRY_TILE_SKIPPING || WAVEFRONT_TRACKING || OVERLAP_EXCHANGE
 
 /**
  * Compute net updates for the block.
@@ -381,14 +1064,66 @@ void SWE_DimensionalSplittingMpi::setGhostLayer() {
  * maximum allowed time step size
  */
 void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
+#if defined(BATCHED_SOLVER)
+    // The bathymetry is static once it has been exchanged, so the edge differences are computed on first use
+    if (!edgeBathymetry.isInitialized()) {
+        edgeBathymetry = EdgeBathymetry(nx, ny);
+        edgeBathymetry.compute(b);
+    }
+#endif // BATCHED_SOLVER
+#if defined(OVERLAP_EXCHANGE)
+    // If the ghost layers are still in flight, the interior edges are computed before waiting for them.
+    // Without local timestepping, all ghost layers are in sync afterwards.
+    float maxWaveSpeed = (float) 0.;
+    const bool interiorComputed = exchangeInFlight;
+    if (exchangeInFlight) {
+        maxWaveSpeed = computeInteriorNetUpdates();
+        finishGhostLayerExchange();
+    }
+#endif // OVERLAP_EXCHANGE
     if (!allGhostlayersInSync()) return;
+#if defined(FUSED_KERNEL)
+    // The net updates are computed together with the cell update in updateUnknowns(),
+    // only the timestep is determined here
+    float maxWaveSpeed = computeMaxCellWaveSpeed();
+#elif defined(DRY_TILE_SKIPPING)
+    long computedEdges;
+    float maxWaveSpeed = computeActiveTileNetUpdates(computedEdges);
+#elif defined(WAVEFRONT_TRACKING)
+    long computedEdges;
+    float maxWaveSpeed = computeWavefrontNetUpdates(computedEdges);
+#elif defined(OVERLAP_EXCHANGE)
+    if (!interiorComputed)
+        maxWaveSpeed = computeInteriorNetUpdates();
+    maxWaveSpeed = std::max(maxWaveSpeed, computeBoundaryNetUpdates());
+#else
 //maximum (linearized) wave speed within one iteration
     float maxWaveSpeed = (float) 0.;
     /***************************************************************************************
      * compute the net-updates for the vertical edges
      **************************************************************************************/
 
+#if defined(HYBRID_THREADING)
+    // Each column of edges is written by one thread, the solver is stateless
+#pragma omp parallel for reduction(max : maxWaveSpeed) schedule(static)
+#endif // HYBRID_THREADING
     for (int i = 1; i < nx+2; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny,
+                h[i - 1] + 1, h[i] + 1,
+                hu[i - 1] + 1, hu[i] + 1,
+                edgeBathymetry.vertical[i - 1],
+                hNetUpdatesLeft[edgeColumn], hNetUpdatesRight[edgeColumn],
+                huNetUpdatesLeft[edgeColumn], huNetUpdatesRight[edgeColumn]
+        ));
+#else
         const int ny_end = ny+1;
 
 #if defined(VECTORIZE)
@@ -404,13 +1139,37 @@ void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
                     h[i - 1][j], h[i][j],
                     hu[i - 1][j], hu[i][j],
                     b[i - 1][j], b[i][j],
-                    hNetUpdatesLeft[i - 1][j - 1], hNetUpdatesRight[i - 1][j - 1],
-                    huNetUpdatesLeft[i - 1][j - 1], huNetUpdatesRight[i - 1][j - 1],
+                    hNetUpdatesLeft[edgeColumn][j - 1], hNetUpdatesRight[edgeColumn][j - 1],
+                    huNetUpdatesLeft[edgeColumn][j - 1], huNetUpdatesRight[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
             maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
         }
-
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // The edges complete cell i - 1 and are the first contribution to cell i
+        if (i > 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i - 1][j] += hNetUpdatesLeft[0][j - 1] / dx;
+                dhu[i - 1][j] += huNetUpdatesLeft[0][j - 1] / dx;
+            }
+        }
+        if (i < nx + 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i][j] = hNetUpdatesRight[0][j - 1] / dx;
+                dhu[i][j] = huNetUpdatesRight[0][j - 1] / dx;
+            }
+        }
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+        progressBetweenColumns(i);
+#endif
     }
 
 
@@ -418,7 +1177,26 @@ void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
      * compute the net-updates for the horizontal edges
      **************************************************************************************/
 
+#if defined(HYBRID_THREADING)
+#pragma omp parallel for reduction(max : maxWaveSpeed) schedule(static)
+#endif // HYBRID_THREADING
     for (int i=1; i < nx + 1; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny + 1,
+                h[i], h[i] + 1,
+                hv[i], hv[i] + 1,
+                edgeBathymetry.horizontal[i - 1],
+                hNetUpdatesBelow[edgeColumn], hNetUpdatesAbove[edgeColumn],
+                hvNetUpdatesBelow[edgeColumn], hvNetUpdatesAbove[edgeColumn]
+        ));
+#else
         const int ny_end = ny+2;
 
 #if defined(VECTORIZE)
@@ -433,8 +1211,8 @@ void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
                     h[i][j - 1], h[i][j],
                     hv[i][j - 1], hv[i][j],
                     b[i][j - 1], b[i][j],
-                    hNetUpdatesBelow[i - 1][j - 1], hNetUpdatesAbove[i - 1][j - 1],
-                    hvNetUpdatesBelow[i - 1][j - 1], hvNetUpdatesAbove[i - 1][j - 1],
+                    hNetUpdatesBelow[edgeColumn][j - 1], hNetUpdatesAbove[edgeColumn][j - 1],
+                    hvNetUpdatesBelow[edgeColumn][j - 1], hvNetUpdatesAbove[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
 
@@ -443,7 +1221,22 @@ void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
             //maxTestSpeed = std::max (maxTestSpeed, maxEdgeSpeed);
 
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Add the contributions of the edges below and above cell (i, j)
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny + 1; j++) {
+            dh[i][j] += (hNetUpdatesAbove[0][j - 1] + hNetUpdatesBelow[0][j]) / dy;
+            dhv[i][j] = (hvNetUpdatesAbove[0][j - 1] + hvNetUpdatesBelow[0][j]) / dy;
+        }
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+        progressBetweenColumns(i);
+#endif
     }
+#endif // FUSED_KERNEL
 
     if (maxWaveSpeed > 0.00001) {
 
@@ -455,7 +1248,12 @@ void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
         maxTimestep = std::numeric_limits<float>::max ();
     }
 
+#if defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+    // Only the edges that were actually solved
+    CollectorMpi::getInstance().addFlops(computedEdges * 135);
+#else
     CollectorMpi::getInstance().addFlops(2*nx * ny * 135);
+#endif
 
     if (localTimestepping) {
         //std::cout << "maxtimestep "<< maxTimestep << std::endl;
@@ -463,31 +1261,216 @@ void SWE_DimensionalSplittingMpi::computeNumericalFluxes() {
 
     } else {
         // compute max timestep according to cautious CFL-condition
+#if defined(NONBLOCKING_REDUCTION)
+        // Completed in updateUnknowns(), after the net updates have been summed up
+        reducedTimestep = maxTimestep;
+        MPI_Iallreduce(&reducedTimestep, &maxTimestepGlobal, 1, MPI_FLOAT, MPI_MIN, communicator, &timestepReduction);
+#elif defined(LAGGED_TIMESTEP)
+        /*
+         * The timestep is a share of the global CFL timestep of the previous step,
+         * so the reduction of the current step runs in the background until the next step.
+         * Only the first step waits for its own reduction.
+         */
         CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_REDUCE);
+        float timestep;
+        if (timestepReduction == MPI_REQUEST_NULL) {
+            MPI_Allreduce(&maxTimestep, &maxTimestepGlobal, 1, MPI_FLOAT, MPI_MIN, communicator);
+            timestep = maxTimestepGlobal;
+        } else {
+            MPI_Wait(&timestepReduction, MPI_STATUS_IGNORE);
+            timestep = laggedTimestepSafety * maxTimestepGlobal;
+        }
+        CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_REDUCE);
 
-        MPI_Allreduce(&maxTimestep, &maxTimestepGlobal, 1, MPI_FLOAT, MPI_MIN, MPI_COMM_WORLD);
+        // The wave speeds grew faster than the safety factor allows
+        if (timestep > maxTimestep && cflViolations++ == 0) {
+            std::cerr << "Warning: the lagged timestep " << timestep << " exceeds the CFL timestep " << maxTimestep
+                      << " in iteration " << iteration << std::endl;
+        }
+
+        reducedTimestep = maxTimestep;
+        MPI_Iallreduce(&reducedTimestep, &maxTimestepGlobal, 1, MPI_FLOAT, MPI_MIN, communicator, &timestepReduction);
+        maxTimestep = timestep;
+#else
+        CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_REDUCE);
+
+        MPI_Allreduce(&maxTimestep, &maxTimestepGlobal, 1, MPI_FLOAT, MPI_MIN, communicator);
 
         CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_REDUCE);
 
         maxTimestep = maxTimestepGlobal;
+#endif
 
     }
     //CollectorMpi::getInstance().addTimestep(maxTimestep);
 }
 
+#if defined(NONBLOCKING_REDUCTION)
+/**
+ * Adds up the net updates of the two vertical and the two horizontal edges of each cell.
+ * Every net update belongs to exactly one cell, so the sums are stored in place:
+ * the vertical sums in the left net updates of the cell's right edge,
+ * the horizontal sums in the below net updates of the cell's upper edge.
+ */
+void SWE_DimensionalSplittingMpi::sumNetUpdates() {
+#if defined(HYBRID_THREADING)
+#pragma omp parallel for schedule(static)
+#endif // HYBRID_THREADING
+    for (int i = 1; i < nx + 1; i++) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny + 1; j++) {
+            hNetUpdatesLeft[i][j - 1] = hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1];
+            huNetUpdatesLeft[i][j - 1] = huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1];
+            hNetUpdatesBelow[i - 1][j] = hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j];
+            hvNetUpdatesBelow[i - 1][j] = hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j];
+        }
+        progressBetweenColumns(i);
+    }
+}
+#endif // NONBLOCKING_REDUCTION
+
 /**
  * Updates the unknowns with the already computed net-updates.
  *
+ * With FUSED_KERNEL, the net updates are computed here as well: the grid is streamed column by column
+ * and only a rolling window of edge updates is kept instead of the full net-update arrays.
+ *
  * @param dt time step width used in the update. The timestep has to be equal to maxTimestep calculated by computeNumericalFluxes(),
  * since this is the step width used for the intermediary updates after the x-sweep.
  */
 void SWE_DimensionalSplittingMpi::updateUnknowns(float dt) {
     if (!allGhostlayersInSync()) return;
+#if defined(NONBLOCKING_REDUCTION)
+    // The summation does not depend on the timestep, so it hides the reduction started in computeNumericalFluxes()
+    sumNetUpdates();
+    if (timestepReduction != MPI_REQUEST_NULL) {
+        CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_REDUCE);
+        MPI_Wait(&timestepReduction, MPI_STATUS_IGNORE);
+        CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_REDUCE);
+        maxTimestep = maxTimestepGlobal;
+    }
+#endif // NONBLOCKING_REDUCTION
 //update cell averages with the net-updates
     dt=maxTimestep;
+#if defined(DRY_TILE_SKIPPING)
+    for (int tileX = 0; tileX < tileActivity.getTilesX(); tileX++) {
+        for (int tileY = 0; tileY < tileActivity.getTilesY(); tileY++) {
+            if (tileActivity.isActive(tileX, tileY)) {
+                updateCells(dt, tileActivity.xBegin(tileX), tileActivity.xEnd(tileX),
+                            tileActivity.yBegin(tileY), tileActivity.yEnd(tileY));
+            }
+        }
+    }
+    // Skipped tiles did not change, only the active ones have to be rescanned
+    tileActivity.updateWet(h, hu, hv);
+    return;
+#endif // DRY_TILE_SKIPPING
+#if defined(WAVEFRONT_TRACKING)
+    updateCells(dt, wavefrontBox.getIBegin(), wavefrontBox.getIEnd(), wavefrontBox.getJBegin(), wavefrontBox.getJEnd());
+    // The box grows only after the update, the net updates outside of it have not been computed
+    trackWavefront();
+    return;
+#endif // WAVEFRONT_TRACKING
+#if defined(FUSED_KERNEL)
+    // Seed the window with the left-most vertical edge, slot (i % 2) holds the edge between column i and i + 1
+#if defined(BATCHED_SOLVER)
+    batchSolver.computeNetUpdates (
+            ny,
+            h[0] + 1, h[1] + 1,
+            hu[0] + 1, hu[1] + 1,
+            edgeBathymetry.vertical[0],
+            hNetUpdatesLeft[0], hNetUpdatesRight[0],
+            huNetUpdatesLeft[0], huNetUpdatesRight[0]
+    );
+#else
+    for (int j = 1; j < ny + 1; j++) {
+        float maxEdgeSpeed;
+
+        solver.computeNetUpdates (
+                h[0][j], h[1][j],
+                hu[0][j], hu[1][j],
+                b[0][j], b[1][j],
+                hNetUpdatesLeft[0][j - 1], hNetUpdatesRight[0][j - 1],
+                huNetUpdatesLeft[0][j - 1], huNetUpdatesRight[0][j - 1],
+                maxEdgeSpeed
+        );
+    }
+#endif // BATCHED_SOLVER
+#endif // FUSED_KERNEL
+#if defined(HYBRID_THREADING)
+    // The same static distribution of the columns as the net updates
+#pragma omp parallel for schedule(static)
+#endif // HYBRID_THREADING
     for (int i = 1; i < nx+1; i++) {
         const int ny_end = ny+1;
 
+#if defined(FUSED_KERNEL)
+        // Edges of column i are solved before the column is overwritten, the left vertical edge is still in the window
+        const int left = (i - 1) % 2;
+        const int right = i % 2;
+
+#if defined(BATCHED_SOLVER)
+        batchSolver.computeNetUpdates (
+                ny,
+                h[i] + 1, h[i + 1] + 1,
+                hu[i] + 1, hu[i + 1] + 1,
+                edgeBathymetry.vertical[i],
+                hNetUpdatesLeft[right], hNetUpdatesRight[right],
+                huNetUpdatesLeft[right], huNetUpdatesRight[right]
+        );
+
+        batchSolver.computeNetUpdates (
+                ny + 1,
+                h[i], h[i] + 1,
+                hv[i], hv[i] + 1,
+                edgeBathymetry.horizontal[i - 1],
+                hNetUpdatesBelow[0], hNetUpdatesAbove[0],
+                hvNetUpdatesBelow[0], hvNetUpdatesAbove[0]
+        );
+#else
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny_end; j++) {
+            float maxEdgeSpeed;
+
+            solver.computeNetUpdates (
+                    h[i][j], h[i + 1][j],
+                    hu[i][j], hu[i + 1][j],
+                    b[i][j], b[i + 1][j],
+                    hNetUpdatesLeft[right][j - 1], hNetUpdatesRight[right][j - 1],
+                    huNetUpdatesLeft[right][j - 1], huNetUpdatesRight[right][j - 1],
+                    maxEdgeSpeed
+            );
+        }
+
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny_end + 1; j++) {
+            float maxEdgeSpeed;
+
+            solver.computeNetUpdates (
+                    h[i][j - 1], h[i][j],
+                    hv[i][j - 1], hv[i][j],
+                    b[i][j - 1], b[i][j],
+                    hNetUpdatesBelow[0][j - 1], hNetUpdatesAbove[0][j - 1],
+                    hvNetUpdatesBelow[0][j - 1], hvNetUpdatesAbove[0][j - 1],
+                    maxEdgeSpeed
+            );
+        }
+#endif // BATCHED_SOLVER
+
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny_end; j++) {
+            h[i][j] -= dt / dx * (hNetUpdatesRight[left][j - 1] + hNetUpdatesLeft[right][j - 1]) + dt / dy * (hNetUpdatesAbove[0][j - 1] + hNetUpdatesBelow[0][j]);
+            hu[i][j] -= dt / dx * (huNetUpdatesRight[left][j - 1] + huNetUpdatesLeft[right][j - 1]);
+            hv[i][j] -= dt / dy * (hvNetUpdatesAbove[0][j - 1] + hvNetUpdatesBelow[0][j]);
+#else
 #if defined(VECTORIZE)
 
         // iterate over all rows, including ghost layer
@@ -495,9 +1478,21 @@ void SWE_DimensionalSplittingMpi::updateUnknowns(float dt) {
 #endif // VECTORIZE
 
         for (int j = 1; j < ny_end; j++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+            h[i][j] -= dt * dh[i][j];
+            hu[i][j] -= dt * dhu[i][j];
+            hv[i][j] -= dt * dhv[i][j];
+#elif defined(NONBLOCKING_REDUCTION)
+            // Sums of the net updates, see sumNetUpdates()
+            h[i][j] -= dt / dx * hNetUpdatesLeft[i][j - 1] + dt / dy * hNetUpdatesBelow[i - 1][j];
+            hu[i][j] -= dt / dx * huNetUpdatesLeft[i][j - 1];
+            hv[i][j] -= dt / dy * hvNetUpdatesBelow[i - 1][j];
+#else
             h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
             hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
             hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
+#endif // ACCUMULATE_NET_UPDATES
+#endif // FUSED_KERNEL
 
             if (h[i][j] < 0) {
                 //TODO: dryTol
@@ -514,5 +1509,8 @@ void SWE_DimensionalSplittingMpi::updateUnknowns(float dt) {
             } else if (h[i][j] < 0.1)
                 hu[i][j] = hv[i][j] = 0.; //no water, no speed!
         }
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+        progressBetweenColumns(i);
+#endif
     }
 }
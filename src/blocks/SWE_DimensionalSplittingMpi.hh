@@ -33,9 +33,11 @@
 #include <limits.h>
 #include <ctime>
 #include <time.h>
+#include <vector>
 #include "blocks/SWE_Block.hh"
 #include "scenarios/SWE_Scenario.hh"
 #include "tools/Float2DNative.hh"
+#include "tools/StateStorage.hh"
 #include "tools/CollectorMpi.hpp"
 #include <mpi.h>
 
@@ -49,17 +51,99 @@
 #include "solvers/AugRie.hpp"
 #endif
 
-class SWE_DimensionalSplittingMpi : public SWE_Block<Float2DNative> {
+#if defined(STATE_STORAGE_COMPACT)
+#if defined(BATCHED_SOLVER)
+#error "The batched solver reads the unknowns as float columns, it cannot be combined with compact state storage"
+#endif
+// h, hu, hv and b are exchanged in their storage type
+#define MPI_STATE_TYPE MPI_UINT16_T
+#elif defined(STATE_STORAGE_DOUBLE)
+#if defined(BATCHED_SOLVER)
+#error "The batched solver reads the unknowns as float columns, it cannot be combined with double state storage"
+#endif
+#define MPI_STATE_TYPE MPI_DOUBLE
+#else
+#define MPI_STATE_TYPE MPI_FLOAT
+#endif
+
+#if defined(INTERLEAVED_STATE) && defined(BATCHED_SOLVER)
+#error "The batched solver reads the unknowns as contiguous columns, it cannot be combined with INTERLEAVED_STATE"
+#endif
+
+#if defined(BATCHED_SOLVER)
+#include "tools/HLLEBatch.hh"
+#include "tools/EdgeBathymetry.hh"
+#endif
+
+#if defined(DRY_TILE_SKIPPING)
+#if defined(FUSED_KERNEL) || defined(ACCUMULATE_NET_UPDATES)
+#error "DRY_TILE_SKIPPING requires the full net-update arrays, it cannot be combined with FUSED_KERNEL or ACCUMULATE_NET_UPDATES"
+#endif
+#include "tools/TileActivity.hh"
+#endif
+
+#if defined(WAVEFRONT_TRACKING)
+#if defined(FUSED_KERNEL) || defined(ACCUMULATE_NET_UPDATES) || defined(DRY_TILE_SKIPPING)
+#error "WAVEFRONT_TRACKING requires the full net-update arrays and its own traversal, it cannot be combined with FUSED_KERNEL, ACCUMULATE_NET_UPDATES or DRY_TILE_SKIPPING"
+#endif
+#include "tools/WavefrontBox.hh"
+#endif
+
+#if defined(NONBLOCKING_REDUCTION)
+#if defined(FUSED_KERNEL) || defined(ACCUMULATE_NET_UPDATES) || defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+#error "NONBLOCKING_REDUCTION sums up the full net-update arrays while the timestep is reduced, it cannot be combined with FUSED_KERNEL, ACCUMULATE_NET_UPDATES, DRY_TILE_SKIPPING or WAVEFRONT_TRACKING"
+#endif
+#if defined(LAGGED_TIMESTEP)
+#error "Only one of NONBLOCKING_REDUCTION and LAGGED_TIMESTEP can be selected"
+#endif
+#endif
+
+#if defined(HYBRID_THREADING)
+#if defined(FUSED_KERNEL) || defined(ACCUMULATE_NET_UPDATES) || defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+#error "HYBRID_THREADING distributes the columns of the full net-update arrays, it cannot be combined with FUSED_KERNEL, ACCUMULATE_NET_UPDATES, DRY_TILE_SKIPPING or WAVEFRONT_TRACKING"
+#endif
+#if WAVE_PROPAGATION_SOLVER != 0
+#error "HYBRID_THREADING shares the solver between the threads, it requires the stateless HLLE solver (WAVE_PROPAGATION_SOLVER=0)"
+#endif
+#endif
+
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+#error "The neighbourhood collective exchanges all ghost layers by MPI, it cannot be combined with SHARED_MEMORY_NEIGHBOURS"
+#endif
+#include "tools/SharedMailbox.hh"
+#endif
+
+#if defined(OVERLAP_EXCHANGE)
+#if defined(FUSED_KERNEL) || defined(ACCUMULATE_NET_UPDATES) || defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING)
+#error "OVERLAP_EXCHANGE splits the edges of the full net-update arrays into interior and boundary edges, it cannot be combined with FUSED_KERNEL, ACCUMULATE_NET_UPDATES, DRY_TILE_SKIPPING or WAVEFRONT_TRACKING"
+#endif
+#endif
+
+// The exchange or the timestep reduction is in flight while the kernels run, see progressCommunication()
+#if defined(OVERLAP_EXCHANGE) || defined(NONBLOCKING_REDUCTION) || defined(LAGGED_TIMESTEP)
+#define ASYNCHRONOUS_COMMUNICATION
+#include <omp.h>
+#endif
+
+class SWE_DimensionalSplittingMpi : public SWE_Block<Float2DState, Float2DStateBuffer> {
 public:
     // Constructor/Destructor
     SWE_DimensionalSplittingMpi(int cellCountHorizontal, int cellCountVertical, float cellSizeHorizontal,
-                                float cellSizeVertical, float originX, float originY, bool localTimestepping);
+                                float cellSizeVertical, float originX, float originY, bool localTimestepping,
+                                MPI_Comm comm = MPI_COMM_WORLD);
 
-    ~SWE_DimensionalSplittingMpi() {};
+    virtual ~SWE_DimensionalSplittingMpi() {};
 
     // Interface methods
     void setGhostLayer();
 
+    // The two phases of setGhostLayer(), see computeNumericalFluxes() for the overlapped exchange.
+    // Blocks with another transport of the ghost layers override these, see SWE_DimensionalSplittingMpiRma
+    virtual void startGhostLayerExchange();
+
+    virtual void finishGhostLayerExchange();
+
     void connectBoundaries(Boundary boundary, SWE_Block &neighbour, Boundary neighbourBoundary);
 
     void computeNumericalFluxes();
@@ -67,14 +151,19 @@ public:
     void updateUnknowns(float dt);
 
     // Mpi specific
-    void freeMpiType();
+    virtual void freeMpiType();
 
-    void connectNeighbours(int neighbourRankId[]);
+    virtual void connectNeighbours(int neighbourRankId[]);
 
     void exchangeBathymetry();
 
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+    // Columns computed between two progress calls, 0 leaves the progress to the MPI calls completing the communication
+    void setProgressInterval(int columns);
+#endif
+
     int iteration = 0;
-private:
+protected:
 #if WAVE_PROPAGATION_SOLVER == 0
     //! Hybrid solver (f-wave + augmented)
     //solver::Hybrid<float> solver;
@@ -87,14 +176,104 @@ private:
     solver::AugRie<float> solver;
 #endif
 
+#if defined(BATCHED_SOLVER)
+    //! Explicitly vectorized HLLE solver, used for whole columns of edges
+    solver::HLLEBatch batchSolver;
+    //! Bathymetry differences of all edges, computed once
+    EdgeBathymetry edgeBathymetry;
+#endif
+
     // Max timestep reduced over all upcxx ranks
     float maxTimestepGlobal;
 
+#if defined(NONBLOCKING_REDUCTION) || defined(LAGGED_TIMESTEP)
+    // Local timestep while it is reduced into maxTimestepGlobal
+    float reducedTimestep;
+    MPI_Request timestepReduction = MPI_REQUEST_NULL;
+#endif
+
+#if defined(NONBLOCKING_REDUCTION)
+    // Adds up the net updates of each cell in place, see updateUnknowns()
+    void sumNetUpdates();
+#endif
+
+#if defined(LAGGED_TIMESTEP)
+    // Share of the previous step's global CFL timestep used as the timestep of the current step
+    static constexpr float laggedTimestepSafety = 0.9f;
+    // Steps whose lagged timestep exceeded the local CFL timestep
+    long cflViolations = 0;
+#endif
+
+#if defined(FUSED_KERNEL)
+    // Upper bound of the edge wave speeds, derived from the cell values
+    float computeMaxCellWaveSpeed();
+#endif
+
+#if defined(DRY_TILE_SKIPPING)
+    // Tiles of tileSize x tileSize cells, tiles that are dry and at rest are skipped
+    static const int tileSize = 32;
+    TileActivity tileActivity;
+
+    // Net updates of all edges adjacent to the active tiles
+    float computeActiveTileNetUpdates(long &computedEdges);
+#endif
+
+#if defined(WAVEFRONT_TRACKING)
+    // Cells reached by a wave, the rest of the block is still at rest
+    WavefrontBox wavefrontBox;
+
+    // Net updates of all edges adjacent to the cells inside the wavefront box
+    float computeWavefrontNetUpdates(long &computedEdges);
+
+    // Adds the cells with non-zero net updates to the wavefront box
+    void trackWavefront();
+#endif
+
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+    int progressInterval = 1;
+
+    // Tests the communication in flight, only called by the master thread
+    void progressCommunication();
+
+    // Called by the kernels after column i
+    inline void progressBetweenColumns(int i) {
+        if (progressInterval > 0 && i % progressInterval == 0 && omp_get_thread_num() == 0)
+            progressCommunication();
+    }
+#endif
+
+#if defined(OVERLAP_EXCHANGE)
+    // Set by startGhostLayerExchange() until the exchange is finished in computeNumericalFluxes()
+    bool exchangeInFlight = false;
+    // The receives have not been found complete yet, see testGhostLayerExchange()
+    bool receivesPending = false;
+
+    virtual void testGhostLayerExchange();
+
+    // Net updates of the edges that do not touch a ghost cell
+    float computeInteriorNetUpdates();
+
+    // Net updates of the edges between the ghost layer and the outermost cells
+    float computeBoundaryNetUpdates();
+#endif
+
+#if defined(DRY_TILE_SKIPPING) || defined(WAVEFRONT_TRACKING) || defined(OVERLAP_EXCHANGE)
+    float computeVerticalEdges(int i, int jBegin, int jEnd);
+
+    float computeHorizontalEdges(int i, int jBegin, int jEnd);
+
+    void updateCells(float dt, int iBegin, int iEnd, int jBegin, int jEnd);
+#endif
+
     // Temporary values after x-sweep and before y-sweep
     Float2DNative hStar;
     Float2DNative huStar;
 
-    // net updates per cell
+    /* net updates per cell
+     * With FUSED_KERNEL, these only hold a rolling window of edges:
+     * the x-sweep arrays keep the two vertical edges of the current column (indexed by column parity),
+     * the y-sweep arrays keep the horizontal edges of the current column (index 0).
+     */
     Float2DNative hNetUpdatesLeft;
     Float2DNative hNetUpdatesRight;
 
@@ -107,6 +286,17 @@ private:
     Float2DNative hvNetUpdatesBelow;
     Float2DNative hvNetUpdatesAbove;
 
+#if defined(ACCUMULATE_NET_UPDATES)
+#if defined(FUSED_KERNEL)
+#error "FUSED_KERNEL does not store any net-update arrays, ACCUMULATE_NET_UPDATES cannot be combined with it"
+#endif
+    // Net updates accumulated per cell and scaled by the cell size,
+    // the edge arrays above then only hold the edges of the current column
+    Float2DNative dh;
+    Float2DNative dhu;
+    Float2DNative dhv;
+#endif
+
     /* Copy buffer:
      * Since Float2D are stored column-wise in memory,
      * it is expensive to read rows from a Float2D since it is necessary to stride an entire column after each read element.
@@ -118,9 +308,91 @@ private:
     // Neighbouring block rank ids, indexed by Boundary
     //int neighbourRankId[4];
 
+    // Communicator of the blocks, e.g. the Cartesian communicator created by swe_mpi
+    MPI_Comm communicator;
+
+    // Timestep sent along with the ghost layers
+    TimeScalar sentTimestep;
+
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+    // Exchange of all ghost layers with one MPI_Ineighbor_alltoallw on a Cartesian communicator, see connectNeighbours()
+    bool useNeighbourCollective = false;
+    MPI_Request neighbourExchange = MPI_REQUEST_NULL;
+
+    // Arguments of the collective, indexed by Boundary, they have to stay valid until it is completed
+    int neighbourSendCounts[4];
+    int neighbourReceiveCounts[4];
+    MPI_Aint neighbourDisplacements[4];
+    MPI_Datatype neighbourSendType[4];
+    MPI_Datatype neighbourReceiveType[4];
+#endif
+
+    // Persistent requests of the ghost layer messages, indexed by Boundary, see connectNeighbours()
+    MPI_Request sendRequests[4] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    MPI_Request receiveRequests[4] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    // Borders whose ghost layer is received by message in the current exchange
+    bool receivingGhostLayer[4];
+
+    // First cell, step to the next cell and number of cells of the inner layer or the ghost layer at border
+    void getLayerRange(Boundary border, bool ghost, int &i, int &j, int &di, int &dj, int &count);
+
+    // Static fields of the cells of the layer at border, exchanged once by exchangeBathymetry()
+    MPI_Datatype createStaticLayerType(Boundary border, bool ghost);
+
+#if defined(SHARED_MEMORY_NEIGHBOURS)
+    // Processes on the same node, the ghost layers of neighbours among them are exchanged through shared memory
+    MPI_Comm nodeCommunicator = MPI_COMM_NULL;
+    // The neighbour at the border is on the same node, indexed by Boundary
+    bool sharedNeighbour[4] = {false, false, false, false};
+    // Borders whose ghost layer is read from the mailbox in the current exchange
+    bool receivingSharedLayer[4];
+
+    // Window border holds the mailboxes of the ghost layers at border of all processes of the node
+    MPI_Win mailboxWindows[4] = {MPI_WIN_NULL, MPI_WIN_NULL, MPI_WIN_NULL, MPI_WIN_NULL};
+    // Mailboxes of the own ghost layers and of the ghost layers of the neighbours facing this block
+    SharedMailbox<StateScalar> receiveMailbox[4];
+    SharedMailbox<StateScalar> sendMailbox[4];
+    // Exchanges through the mailboxes so far, indexed by Boundary
+    long sentExchanges[4] = {0, 0, 0, 0};
+    long receivedExchanges[4] = {0, 0, 0, 0};
+
+    void connectSharedNeighbours();
+
+    void writeSharedLayer(Boundary border);
+
+    void readSharedLayer(Boundary border);
+#endif
+
+#if defined(INTERLEAVED_STATE)
+    // h, hu and hv of the boundary cells of a column/row
+    MPI_Datatype CELL_COLUMN;
+    MPI_Datatype CELL_ROW;
+
+    // Timestep and boundary cells of the outgoing and incoming ghost layers, indexed by Boundary.
+    // These use absolute addresses and are sent/received at MPI_BOTTOM, one message per boundary.
+    MPI_Datatype sendLayer[4];
+    MPI_Datatype receiveLayer[4];
+
+    static MPI_Datatype createLayerType(TimeScalar *timestep, void *cells, MPI_Datatype cellType);
+#else
     // Custom data types for bottom/top border which are requrired due to the stride
     MPI_Datatype HORIZONTAL_BOUNDARY;
 
+    // Contiguous messages of the ghost layers, indexed by Boundary, see packGhostLayer()
+    std::vector<char> sendBuffer[4];
+    std::vector<char> receiveBuffer[4];
+
+    void getLayerCells(Boundary border, bool ghost, int &i, int &j, int &count, MPI_Datatype &type);
+
+    void packGhostLayer(Boundary border, TimeScalar timestep);
+
+    void unpackGhostLayer(Boundary border);
+
+#if defined(NEIGHBOURHOOD_COLLECTIVES)
+    MPI_Datatype createNeighbourLayerType(Boundary border, bool ghost);
+#endif
+#endif
+
 };
 
 #endif /* SWEDIMENSIONALSPLITTINGMPI_HH_ */
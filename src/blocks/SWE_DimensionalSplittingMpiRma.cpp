@@ -0,0 +1,206 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of SWE_DimensionalSplittingMpiRma.hh
+ *
+ */
+#include "SWE_DimensionalSplittingMpiRma.hh"
+
+#include <cassert>
+
+SWE_DimensionalSplittingMpiRma::SWE_DimensionalSplittingMpiRma(int nx, int ny, float dx, float dy, float originX,
+                                                               float originY, bool localTimestepping,
+                                                               MPI_Comm comm) :
+        SWE_DimensionalSplittingMpi(nx, ny, dx, dy, originX, originY, localTimestepping, comm) {
+    for (int border = 0; border < 4; border++) {
+        neighbourCells[border] = MPI_DATATYPE_NULL;
+    }
+}
+
+void SWE_DimensionalSplittingMpiRma::freeMpiType() {
+    for (int border = 0; border < 4; border++) {
+        if (neighbourCells[border] != MPI_DATATYPE_NULL)
+            MPI_Type_free(&neighbourCells[border]);
+    }
+    MPI_Win_detach(ghostWindow, bufferH.getRawPointer());
+    MPI_Win_detach(ghostWindow, bufferHu.getRawPointer());
+    MPI_Win_detach(ghostWindow, bufferHv.getRawPointer());
+    MPI_Win_detach(ghostWindow, borderTimestep);
+    MPI_Win_free(&ghostWindow);
+    MPI_Group_free(&communicatorGroup);
+
+    SWE_DimensionalSplittingMpi::freeMpiType();
+}
+
+/**
+ * Creates the ghost window and fetches the layout of the neighbours' ghost layers.
+ * Has to be called after the boundary types have been set by initScenario().
+ */
+void SWE_DimensionalSplittingMpiRma::connectNeighbours(int p_neighbourRankId[]) {
+    SWE_DimensionalSplittingMpi::connectNeighbours(p_neighbourRankId);
+
+    // The arrays are attached as a whole, the neighbours only access their ghost layers
+    MPI_Win_create_dynamic(MPI_INFO_NULL, communicator, &ghostWindow);
+    const MPI_Aint arraySize = (MPI_Aint) bufferH.getCols() * bufferH.getStride() * sizeof(StateScalar);
+    MPI_Win_attach(ghostWindow, bufferH.getRawPointer(), arraySize);
+    MPI_Win_attach(ghostWindow, bufferHu.getRawPointer(), arraySize);
+    MPI_Win_attach(ghostWindow, bufferHv.getRawPointer(), arraySize);
+    MPI_Win_attach(ghostWindow, borderTimestep, sizeof(borderTimestep));
+
+    MPI_Comm_group(communicator, &communicatorGroup);
+
+    const int sendTags[4] = {MPI_TAG_TIMESTEP_LEFT, MPI_TAG_TIMESTEP_RIGHT, MPI_TAG_TIMESTEP_BOTTOM,
+                             MPI_TAG_TIMESTEP_TOP};
+    const int receiveTags[4] = {MPI_TAG_TIMESTEP_RIGHT, MPI_TAG_TIMESTEP_LEFT, MPI_TAG_TIMESTEP_TOP,
+                                MPI_TAG_TIMESTEP_BOTTOM};
+
+    for (int border = 0; border < 4; border++) {
+        if (boundaryType[border] != CONNECT)
+            continue;
+
+        int i, j, count;
+        MPI_Datatype type;
+        getLayerCells(static_cast<Boundary>(border), true, i, j, count, type);
+
+        MPI_Aint layout[layoutSize];
+        MPI_Get_address(&borderTimestep[border], &layout[LAYOUT_TIMESTEP]);
+        MPI_Get_address(&bufferH[i][j], &layout[LAYOUT_H]);
+        MPI_Get_address(&bufferHu[i][j], &layout[LAYOUT_HU]);
+        MPI_Get_address(&bufferHv[i][j], &layout[LAYOUT_HV]);
+        layout[LAYOUT_STRIDE] = bufferH.getStride();
+
+        MPI_Sendrecv(layout, layoutSize, MPI_AINT, neighbourRankId[border], sendTags[border],
+                     neighbourLayout[border], layoutSize, MPI_AINT, neighbourRankId[border], receiveTags[border],
+                     communicator, MPI_STATUS_IGNORE);
+
+        // Blocks next to each other have the same number of boundary cells, but may differ in the column stride
+        if (border == BND_LEFT || border == BND_RIGHT)
+            MPI_Type_contiguous(ny, MPI_STATE_TYPE, &neighbourCells[border]);
+        else
+            MPI_Type_vector(nx, 1, (int) neighbourLayout[border][LAYOUT_STRIDE], MPI_STATE_TYPE,
+                            &neighbourCells[border]);
+        MPI_Type_commit(&neighbourCells[border]);
+    }
+}
+
+MPI_Group SWE_DimensionalSplittingMpiRma::neighbourGroup(const bool borders[4]) {
+    int ranks[4];
+    int size = 0;
+    for (int border = 0; border < 4; border++) {
+        if (borders[border])
+            ranks[size++] = neighbourRankId[border];
+    }
+
+    MPI_Group group;
+    MPI_Group_incl(communicatorGroup, size, ranks, &group);
+    return group;
+}
+
+/**
+ * Applies the boundary conditions and puts the timestep and the boundary cells into the neighbours' ghost layers.
+ */
+void SWE_DimensionalSplittingMpiRma::startGhostLayerExchange() {
+    // Apply appropriate conditions for OUTFLOW/WALL boundaries
+    SWE_Block::applyBoundaryConditions();
+
+    CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_EXCHANGE);
+    sentTimestep = getTotalLocalTimestep();
+
+    bool sending[4];
+    for (int border = 0; border < 4; border++) {
+        sending[border] = boundaryType[border] == CONNECT && isSendable(static_cast<Boundary>(border));
+        receivingGhostLayer[border] = boundaryType[border] == CONNECT && isReceivable(static_cast<Boundary>(border));
+    }
+
+    // Every block exposes its ghost layers before it accesses the neighbours' ones,
+    // MPI_Win_start() may wait for the matching posts
+    MPI_Group exposureGroup = neighbourGroup(receivingGhostLayer);
+    MPI_Group accessGroup = neighbourGroup(sending);
+    MPI_Win_post(exposureGroup, 0, ghostWindow);
+    MPI_Win_start(accessGroup, 0, ghostWindow);
+    MPI_Group_free(&exposureGroup);
+    MPI_Group_free(&accessGroup);
+    exposureOpen = true;
+
+    for (int border = 0; border < 4; border++) {
+        if (!sending[border])
+            continue;
+
+        int i, j, count;
+        MPI_Datatype type;
+        getLayerCells(static_cast<Boundary>(border), false, i, j, count, type);
+
+        const int rank = neighbourRankId[border];
+        const MPI_Aint *layout = neighbourLayout[border];
+        MPI_Put(&sentTimestep, 1, MPI_TIME_TYPE, rank, layout[LAYOUT_TIMESTEP], 1, MPI_TIME_TYPE, ghostWindow);
+        MPI_Put(&h[i][j], count, type, rank, layout[LAYOUT_H], 1, neighbourCells[border], ghostWindow);
+        MPI_Put(&hu[i][j], count, type, rank, layout[LAYOUT_HU], 1, neighbourCells[border], ghostWindow);
+        MPI_Put(&hv[i][j], count, type, rank, layout[LAYOUT_HV], 1, neighbourCells[border], ghostWindow);
+    }
+
+    CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_EXCHANGE);
+#if defined(OVERLAP_EXCHANGE)
+    exchangeInFlight = true;
+    receivesPending = true;
+#endif
+}
+
+/**
+ * Completes the puts of this block and waits for the puts of the neighbours into the ghost layers.
+ */
+void SWE_DimensionalSplittingMpiRma::finishGhostLayerExchange() {
+    CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_EXCHANGE);
+
+    // The boundary cells may be updated once the access epoch is completed
+    MPI_Win_complete(ghostWindow);
+    if (exposureOpen)
+        MPI_Win_wait(ghostWindow);
+    exposureOpen = false;
+
+    checkAllGhostlayers();
+
+    CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_EXCHANGE);
+#if defined(OVERLAP_EXCHANGE)
+    exchangeInFlight = false;
+    receivesPending = false;
+#endif
+
+    iteration++;
+}
+
+#if defined(OVERLAP_EXCHANGE)
+/**
+ * Checks whether the neighbours have completed their puts, which also completes the exposure epoch.
+ */
+void SWE_DimensionalSplittingMpiRma::testGhostLayerExchange() {
+    if (!receivesPending)
+        return;
+
+    int received;
+    MPI_Win_test(ghostWindow, &received);
+    if (received) {
+        CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_HIDDEN_EXCHANGE);
+        receivesPending = false;
+        exposureOpen = false;
+    }
+}
+#endif // OVERLAP_EXCHANGE
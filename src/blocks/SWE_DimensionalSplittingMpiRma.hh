@@ -0,0 +1,89 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * MPI block which exchanges the ghost layers with one-sided communication, like the UPC++ block does with rput.
+ *
+ * The ghost cells of bufferH, bufferHu, bufferHv and the border timesteps are exposed in a dynamic MPI window.
+ * Each block puts its boundary cells and its timestep directly into the ghost cells of its neighbours,
+ * synchronized by general active target synchronization (MPI_Win_post/start/complete/wait):
+ * a block exposes its ghost layers to the neighbours it receives from and
+ * accesses the ghost layers of the neighbours it sends to.
+ *
+ * Everything else, including the bathymetry exchange, is inherited from SWE_DimensionalSplittingMpi.
+ */
+
+#ifndef SWEDIMENSIONALSPLITTINGMPIRMA_HH_
+#define SWEDIMENSIONALSPLITTINGMPIRMA_HH_
+
+#include "blocks/SWE_DimensionalSplittingMpi.hh"
+
+#if defined(INTERLEAVED_STATE)
+#error "SWE_DimensionalSplittingMpiRma puts h, hu and hv into separate arrays, INTERLEAVED_STATE is not supported"
+#endif
+
+class SWE_DimensionalSplittingMpiRma : public SWE_DimensionalSplittingMpi {
+public:
+    SWE_DimensionalSplittingMpiRma(int cellCountHorizontal, int cellCountVertical, float cellSizeHorizontal,
+                                   float cellSizeVertical, float originX, float originY, bool localTimestepping,
+                                   MPI_Comm comm = MPI_COMM_WORLD);
+
+    ~SWE_DimensionalSplittingMpiRma() {};
+
+    void startGhostLayerExchange() override;
+
+    void finishGhostLayerExchange() override;
+
+    void freeMpiType() override;
+
+    void connectNeighbours(int neighbourRankId[]) override;
+
+protected:
+#if defined(OVERLAP_EXCHANGE)
+    void testGhostLayerExchange() override;
+#endif
+
+private:
+    // Addresses of a ghost layer in the window: timestep, h, hu and hv of its first cell, and the column stride
+    enum LayoutEntry {
+        LAYOUT_TIMESTEP = 0, LAYOUT_H = 1, LAYOUT_HU = 2, LAYOUT_HV = 3, LAYOUT_STRIDE = 4
+    };
+    static const int layoutSize = 5;
+
+    // Window of the ghost cells and the border timesteps
+    MPI_Win ghostWindow = MPI_WIN_NULL;
+
+    // Layout of the ghost layer of each neighbour facing this block, indexed by Boundary
+    MPI_Aint neighbourLayout[4][layoutSize];
+
+    // Datatype of the boundary cells in the ghost layer of the neighbour, indexed by Boundary
+    MPI_Datatype neighbourCells[4];
+
+    // Group of the communicator, the epochs use subgroups of the neighbours
+    MPI_Group communicatorGroup;
+
+    // The exposure epoch of the current exchange has not been completed yet
+    bool exposureOpen = false;
+
+    // Creates the group of the neighbours at the borders which are set in borders
+    MPI_Group neighbourGroup(const bool borders[4]);
+};
+
+#endif /* SWEDIMENSIONALSPLITTINGMPIRMA_HH_ */
@@ -76,6 +76,25 @@ SWE_DimensionalSplittingUpcxx::SWE_DimensionalSplittingUpcxx(int nx, int ny, flo
          * Down-going wave from the top edge, analogue for the bottom edge
          */
 
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the edges of the current column are stored, see computeNumericalFluxes()
+        hNetUpdatesLeft(1, ny + 2),
+        hNetUpdatesRight(1, ny + 2),
+
+        huNetUpdatesLeft(1, ny + 2),
+        huNetUpdatesRight(1, ny + 2),
+
+        hNetUpdatesBelow(1, ny + 2),
+        hNetUpdatesAbove(1, ny + 2),
+
+        hvNetUpdatesBelow(1, ny + 2),
+        hvNetUpdatesAbove(1, ny + 2),
+
+        // Accumulated net updates per cell
+        dh(nx + 2, ny + 2),
+        dhu(nx + 2, ny + 2),
+        dhv(nx + 2, ny + 2) {
+#else
         // For the x-sweep
         hNetUpdatesLeft(nx + 2, ny + 2),
         hNetUpdatesRight(nx + 2, ny + 2),
@@ -89,9 +108,10 @@ SWE_DimensionalSplittingUpcxx::SWE_DimensionalSplittingUpcxx(int nx, int ny, flo
 
         hvNetUpdatesBelow(nx + 1, ny + 2),
         hvNetUpdatesAbove(nx + 1, ny + 2) {
+#endif // ACCUMULATE_NET_UPDATES
 
 
-    upcxxLocalTimestep = upcxx::new_array<float>(4);
+    upcxxLocalTimestep = upcxx::new_array<TimeScalar>(4);
     upcxxBorderTimestep = upcxxLocalTimestep.local();
     upcxxDataReady = upcxx::new_array<std::atomic<bool>>(4);
     dataReady = upcxxDataReady.local();
@@ -328,7 +348,7 @@ void SWE_DimensionalSplittingUpcxx::setGhostLayer() {
     //    dataReady[i] = false;
     }
 
-    float totalLocalTimestep = getTotalLocalTimestep();
+    TimeScalar totalLocalTimestep = getTotalLocalTimestep();
 
 
     if (boundaryType[BND_LEFT] == CONNECT && isSendable(BND_LEFT)) {
@@ -473,6 +493,13 @@ void SWE_DimensionalSplittingUpcxx::setGhostLayer() {
  */
 void SWE_DimensionalSplittingUpcxx::computeNumericalFluxes() {
     if (!allGhostlayersInSync()) return;
+#if defined(BATCHED_SOLVER)
+    // The bathymetry is static once it has been exchanged, so the edge differences are computed on first use
+    if (!edgeBathymetry.isInitialized()) {
+        edgeBathymetry = EdgeBathymetry(nx, ny);
+        edgeBathymetry.compute(b);
+    }
+#endif // BATCHED_SOLVER
 //maximum (linearized) wave speed within one iteration
     float maxWaveSpeed = (float) 0.;
     float maxEdgeSpeed = 0;
@@ -481,6 +508,22 @@ void SWE_DimensionalSplittingUpcxx::computeNumericalFluxes() {
      **************************************************************************************/
 
     for (int i = 1; i < nx+2; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny,
+                h[i - 1] + 1, h[i] + 1,
+                hu[i - 1] + 1, hu[i] + 1,
+                edgeBathymetry.vertical[i - 1],
+                hNetUpdatesLeft[edgeColumn], hNetUpdatesRight[edgeColumn],
+                huNetUpdatesLeft[edgeColumn], huNetUpdatesRight[edgeColumn]
+        ));
+#else
         const int ny_end = ny+1;
 
 #if defined(VECTORIZE)
@@ -495,12 +538,34 @@ void SWE_DimensionalSplittingUpcxx::computeNumericalFluxes() {
                     h[i - 1][j], h[i][j],
                     hu[i - 1][j], hu[i][j],
                     b[i - 1][j], b[i][j],
-                    hNetUpdatesLeft[i - 1][j - 1], hNetUpdatesRight[i - 1][j - 1],
-                    huNetUpdatesLeft[i - 1][j - 1], huNetUpdatesRight[i - 1][j - 1],
+                    hNetUpdatesLeft[edgeColumn][j - 1], hNetUpdatesRight[edgeColumn][j - 1],
+                    huNetUpdatesLeft[edgeColumn][j - 1], huNetUpdatesRight[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
             maxWaveSpeed = std::max(maxWaveSpeed, maxEdgeSpeed);
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // The edges complete cell i - 1 and are the first contribution to cell i
+        if (i > 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i - 1][j] += hNetUpdatesLeft[0][j - 1] / dx;
+                dhu[i - 1][j] += huNetUpdatesLeft[0][j - 1] / dx;
+            }
+        }
+        if (i < nx + 1) {
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+            for (int j = 1; j < ny + 1; j++) {
+                dh[i][j] = hNetUpdatesRight[0][j - 1] / dx;
+                dhu[i][j] = huNetUpdatesRight[0][j - 1] / dx;
+            }
+        }
+#endif // ACCUMULATE_NET_UPDATES
 
     }
 
@@ -510,6 +575,22 @@ void SWE_DimensionalSplittingUpcxx::computeNumericalFluxes() {
      **************************************************************************************/
 
     for (int i=1; i < nx + 1; i++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Only the current column of edges is stored
+        const int edgeColumn = 0;
+#else
+        const int edgeColumn = i - 1;
+#endif // ACCUMULATE_NET_UPDATES
+#if defined(BATCHED_SOLVER)
+        maxWaveSpeed = std::max(maxWaveSpeed, batchSolver.computeNetUpdates (
+                ny + 1,
+                h[i], h[i] + 1,
+                hv[i], hv[i] + 1,
+                edgeBathymetry.horizontal[i - 1],
+                hNetUpdatesBelow[edgeColumn], hNetUpdatesAbove[edgeColumn],
+                hvNetUpdatesBelow[edgeColumn], hvNetUpdatesAbove[edgeColumn]
+        ));
+#else
         const int ny_end = ny+2;
 
 #if defined(VECTORIZE)
@@ -523,8 +604,8 @@ void SWE_DimensionalSplittingUpcxx::computeNumericalFluxes() {
                     h[i][j - 1], h[i][j],
                     hv[i][j - 1], hv[i][j],
                     b[i][j - 1], b[i][j],
-                    hNetUpdatesBelow[i - 1][j - 1], hNetUpdatesAbove[i - 1][j - 1],
-                    hvNetUpdatesBelow[i - 1][j - 1], hvNetUpdatesAbove[i - 1][j - 1],
+                    hNetUpdatesBelow[edgeColumn][j - 1], hNetUpdatesAbove[edgeColumn][j - 1],
+                    hvNetUpdatesBelow[edgeColumn][j - 1], hvNetUpdatesAbove[edgeColumn][j - 1],
                     maxEdgeSpeed
             );
 
@@ -533,6 +614,17 @@ void SWE_DimensionalSplittingUpcxx::computeNumericalFluxes() {
             //maxTestSpeed = std::max (maxTestSpeed, maxEdgeSpeed);
 
         }
+#endif // BATCHED_SOLVER
+#if defined(ACCUMULATE_NET_UPDATES)
+        // Add the contributions of the edges below and above cell (i, j)
+#if defined(VECTORIZE)
+#pragma omp simd
+#endif // VECTORIZE
+        for (int j = 1; j < ny + 1; j++) {
+            dh[i][j] += (hNetUpdatesAbove[0][j - 1] + hNetUpdatesBelow[0][j]) / dy;
+            dhv[i][j] = (hvNetUpdatesAbove[0][j - 1] + hvNetUpdatesBelow[0][j]) / dy;
+        }
+#endif // ACCUMULATE_NET_UPDATES
     }
 
     if (maxWaveSpeed > 0.00001) {
@@ -585,9 +677,15 @@ void SWE_DimensionalSplittingUpcxx::updateUnknowns(float dt) {
 #endif // VECTORIZE
 
         for (int j = 1; j < ny_end; j++) {
+#if defined(ACCUMULATE_NET_UPDATES)
+            h[i][j] -= dt * dh[i][j];
+            hu[i][j] -= dt * dhu[i][j];
+            hv[i][j] -= dt * dhv[i][j];
+#else
             h[i][j] -= dt / dx * (hNetUpdatesRight[i - 1][j - 1] + hNetUpdatesLeft[i][j - 1]) + dt / dy * (hNetUpdatesAbove[i - 1][j - 1] + hNetUpdatesBelow[i - 1][j]);
             hu[i][j] -= dt / dx * (huNetUpdatesRight[i - 1][j - 1] + huNetUpdatesLeft[i][j - 1]);
             hv[i][j] -= dt / dy * (hvNetUpdatesAbove[i - 1][j - 1] + hvNetUpdatesBelow[i - 1][j]);
+#endif // ACCUMULATE_NET_UPDATES
 
             if (h[i][j] < 0) {
                 //TODO: dryTol
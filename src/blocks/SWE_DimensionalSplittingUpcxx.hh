@@ -50,6 +50,11 @@
 #include "solvers/AugRie.hpp"
 #endif
 
+#if defined(BATCHED_SOLVER)
+#include "tools/HLLEBatch.hh"
+#include "tools/EdgeBathymetry.hh"
+#endif
+
 class SWE_DimensionalSplittingUpcxx : public SWE_Block<Float2DUpcxx, Float2DBufferUpcxx> {
 public:
     // Constructor/Destructor
@@ -96,6 +101,13 @@ public:
     solver::AugRie<float> solver;
 #endif
 
+#if defined(BATCHED_SOLVER)
+    //! Explicitly vectorized HLLE solver, used for whole columns of edges
+    solver::HLLEBatch batchSolver;
+    //! Bathymetry differences of all edges, computed once
+    EdgeBathymetry edgeBathymetry;
+#endif
+
     // Max timestep reduced over all upcxx ranks
     float maxTimestepGlobal;
 
@@ -116,16 +128,24 @@ public:
     Float2DUpcxx hvNetUpdatesBelow;
     Float2DUpcxx hvNetUpdatesAbove;
 
+#if defined(ACCUMULATE_NET_UPDATES)
+    // Net updates accumulated per cell and scaled by the cell size,
+    // the edge arrays above then only hold the edges of the current column
+    Float2DUpcxx dh;
+    Float2DUpcxx dhu;
+    Float2DUpcxx dhv;
+#endif
+
     // Interfaces to neighbouring block copy layers, indexed by Boundary
     BlockConnectInterface<upcxx::global_ptr < float>> neighbourCopyLayer[4];
     //Used to transmit timestep in localtimestepping
-    upcxx::global_ptr<float> upcxxLocalTimestep;
+    upcxx::global_ptr<TimeScalar> upcxxLocalTimestep;
     upcxx::global_ptr <std::atomic<bool>> upcxxDataReady;
     upcxx::global_ptr <std::atomic<bool>> upcxxDataTransmitted;
     upcxx::global_ptr<int> upcxxIteration;
     std::atomic<bool> *dataReady;
     std::atomic<bool> *dataTransmitted;
-    float *upcxxBorderTimestep;
+    TimeScalar *upcxxBorderTimestep;
     // timer
 
 };
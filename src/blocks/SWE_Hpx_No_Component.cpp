@@ -289,7 +289,7 @@ void SWE_Hpx_No_Component::run() {
     }
 
 
-    float t = 0.;
+    TimeScalar t = 0.;
     bool synchronizedTimestep = true;
 
     float timestep;
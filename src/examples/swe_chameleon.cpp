@@ -254,7 +254,7 @@ int main(int argc, char** argv) {
 
 
 
-    float t = 0.;
+    TimeScalar t = 0.;
     bool synchronizedTimestep = true;
 
     float timestep;
@@ -98,7 +98,7 @@ swe_charm::swe_charm(CkArgMsg *msg) {
     bool write = false;
     // Declare variables for the output and the simulation time
     std::string outputFilename;
-    float t = 0.;
+    TimeScalar t = 0.;
 
     // Parse command line arguments
     tools::Args::Result ret = args.parse(msg->argc, msg->argv);
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Accuracy comparison of two netCDF outputs written by NetCdfWriter,
+ * e.g. a run with compact state storage (STATE_STORAGE_HALF/STATE_STORAGE_BFLOAT16) against the fp32 run
+ * of the same scenario, resolution and decomposition.
+ *
+ * For each time step and each of h, hu and hv, the maximum absolute error,
+ * the root mean square error and the relative L2 error are printed,
+ * together with the relative deviation of the total water volume.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <netcdf.h>
+
+#include "tools/args.hh"
+
+/**
+ * Read-only access to one output file.
+ */
+class OutputFile {
+public:
+    OutputFile(const std::string &fileName) :
+            fileName(fileName) {
+        check(nc_open(fileName.c_str(), NC_NOWRITE, &dataFile));
+        timeSteps = dimension("time");
+        nx = dimension("x");
+        ny = dimension("y");
+    }
+
+    ~OutputFile() {
+        nc_close(dataFile);
+    }
+
+    /**
+     * Reads the variable at time step t (row by row, nx values per row).
+     */
+    std::vector<float> read(const std::string &variable, size_t t) const {
+        int varId;
+        check(nc_inq_varid(dataFile, variable.c_str(), &varId));
+
+        std::vector<float> values(nx * ny);
+        size_t start[] = {t, 0, 0};
+        size_t count[] = {1, ny, nx};
+        check(nc_get_vara_float(dataFile, varId, start, count, values.data()));
+        return values;
+    }
+
+    float readTime(size_t t) const {
+        int varId;
+        check(nc_inq_varid(dataFile, "time", &varId));
+
+        float time;
+        check(nc_get_var1_float(dataFile, varId, &t, &time));
+        return time;
+    }
+
+    size_t timeSteps;
+    size_t nx;
+    size_t ny;
+
+private:
+    size_t dimension(const char *name) const {
+        int dimId;
+        size_t length;
+        check(nc_inq_dimid(dataFile, name, &dimId));
+        check(nc_inq_dimlen(dataFile, dimId, &length));
+        return length;
+    }
+
+    void check(int status) const {
+        if (status != NC_NOERR) {
+            std::cerr << "Error reading " << fileName << ": " << nc_strerror(status) << std::endl;
+            exit(1);
+        }
+    }
+
+    std::string fileName;
+    int dataFile;
+};
+
+int main(int argc, char **argv) {
+    tools::Args args;
+    args.addOption("reference", 'r', "Output file of the reference run (fp32)");
+    args.addOption("compare", 'c', "Output file of the run to compare");
+
+    tools::Args::Result ret = args.parse(argc, argv);
+    switch (ret) {
+        case tools::Args::Error:
+            return 1;
+        case tools::Args::Help:
+            return 0;
+        case tools::Args::Success:
+            break;
+    }
+
+    OutputFile reference(args.getArgument<std::string>("reference"));
+    OutputFile compare(args.getArgument<std::string>("compare"));
+
+    if (reference.nx != compare.nx || reference.ny != compare.ny || reference.timeSteps != compare.timeSteps) {
+        std::cerr << "The outputs have different dimensions or numbers of time steps" << std::endl;
+        return 1;
+    }
+
+    // The water height is stored as "ah" by NetCdfWriter
+    const char *variables[] = {"ah", "hu", "hv"};
+    const char *names[] = {"h", "hu", "hv"};
+
+    printf("%10s %4s %14s %14s %14s\n", "time", "var", "max abs", "rms", "rel L2");
+    for (size_t t = 0; t < reference.timeSteps; t++) {
+        const float time = reference.readTime(t);
+
+        for (int v = 0; v < 3; v++) {
+            const std::vector<float> expected = reference.read(variables[v], t);
+            const std::vector<float> actual = compare.read(variables[v], t);
+
+            double maxError = 0;
+            double squaredError = 0;
+            double squaredNorm = 0;
+            for (size_t k = 0; k < expected.size(); k++) {
+                const double error = std::abs((double) actual[k] - expected[k]);
+                maxError = std::max(maxError, error);
+                squaredError += error * error;
+                squaredNorm += (double) expected[k] * expected[k];
+            }
+
+            printf("%10.4f %4s %14.6e %14.6e %14.6e\n", time, names[v], maxError,
+                   std::sqrt(squaredError / expected.size()),
+                   squaredNorm > 0 ? std::sqrt(squaredError / squaredNorm) : 0.);
+
+            if (v == 0) {
+                double volumeExpected = 0;
+                double volumeActual = 0;
+                for (size_t k = 0; k < expected.size(); k++) {
+                    volumeExpected += expected[k];
+                    volumeActual += actual[k];
+                }
+                printf("%10.4f %4s %14s %14s %14.6e\n", time, "vol", "", "",
+                       volumeExpected > 0 ? std::abs(volumeActual - volumeExpected) / volumeExpected : 0.);
+            }
+        }
+    }
+
+    return 0;
+}
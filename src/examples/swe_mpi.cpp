@@ -55,8 +55,18 @@
 
 #endif
 
+#if defined(RMA_EXCHANGE)
+// swe_benchmark_mpi_rma: the ghost layers are put into the neighbours' windows
+#include "blocks/SWE_DimensionalSplittingMpiRma.hh"
+typedef SWE_DimensionalSplittingMpiRma SWE_MpiBlock;
+#else
 #include "blocks/SWE_DimensionalSplittingMpi.hh"
+typedef SWE_DimensionalSplittingMpi SWE_MpiBlock;
+#endif
 #include <mpi.h>
+#if defined(HYBRID_THREADING)
+#include <omp.h>
+#endif
 
 int main(int argc, char **argv) {
 
@@ -80,6 +90,14 @@ int main(int argc, char **argv) {
     args.addOption("output-basepath", 'o', "Output base file name");
     args.addOption("write", 'w', "Write results", tools::Args::Required, false);
     args.addOption("local-timestepping", 'l', "Activate local timestepping", tools::Args::Required, false);
+#if defined(HYBRID_THREADING)
+    args.addOption("threads-per-rank", 'p', "Number of OpenMP threads of each rank (default: OMP_NUM_THREADS)",
+                   tools::Args::Required, false);
+#endif // HYBRID_THREADING
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+    args.addOption("progress-interval", 'g', "Columns computed between two tests of the communication in flight, 0 disables the tests (default: 1)",
+                   tools::Args::Required, false);
+#endif // ASYNCHRONOUS_COMMUNICATION
     // Declare the variables needed to hold command line input
     float simulationDuration;
     int numberOfCheckPoints;
@@ -156,9 +174,23 @@ int main(int argc, char **argv) {
     float dySimulation = (float) heightScenario / nyRequested;
 
     // initialize MPI
+#if defined(HYBRID_THREADING)
+    // The kernels are threaded, MPI is only called by the master thread
+    int threadSupport;
+    if (MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &threadSupport) != MPI_SUCCESS) {
+        std::cerr << "MPI_Init_thread failed." << std::endl;
+    }
+    if (threadSupport < MPI_THREAD_FUNNELED) {
+        std::cerr << "MPI does not support MPI_THREAD_FUNNELED." << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (args.isSet("threads-per-rank") && args.getArgument<int>("threads-per-rank") > 0)
+        omp_set_num_threads(args.getArgument<int>("threads-per-rank"));
+#else
     if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
         std::cerr << "MPI_Init failed." << std::endl;
     }
+#endif // HYBRID_THREADING
 
     int myMpiRank;
     int totalMpiRanks;
@@ -170,6 +202,10 @@ int main(int argc, char **argv) {
     gethostname(hostname, HOST_NAME_MAX);
 
     printf("%i Spawned at %s\n", myMpiRank, hostname);
+#if defined(HYBRID_THREADING)
+    if (myMpiRank == 0)
+        printf("Hybrid layout: %i ranks x %i threads\n", totalMpiRanks, omp_get_max_threads());
+#endif // HYBRID_THREADING
 
     /*
      * determine the layout of UPC++ ranks:
@@ -182,9 +218,19 @@ int main(int argc, char **argv) {
     while (totalMpiRanks % blockCountY != 0) blockCountY--;
     int blockCountX = totalMpiRanks / blockCountY;
 
+    // Cartesian communicator of the blocks, MPI may reorder the ranks to match the network topology.
+    // The blocks use its ranks, so the output files are named by the position of the block.
+    MPI_Comm cartesianComm;
+    int blockCounts[2] = {blockCountX, blockCountY};
+    int periods[2] = {0, 0};
+    MPI_Cart_create(MPI_COMM_WORLD, 2, blockCounts, periods, 1, &cartesianComm);
+    MPI_Comm_rank(cartesianComm, &myMpiRank);
+
     // determine the local block position of each SWE_Block
-    int localBlockPositionX = myMpiRank / blockCountY;
-    int localBlockPositionY = myMpiRank % blockCountY;
+    int blockPosition[2];
+    MPI_Cart_coords(cartesianComm, myMpiRank, 2, blockPosition);
+    int localBlockPositionX = blockPosition[0];
+    int localBlockPositionY = blockPosition[1];
 
     // compute local number of cells for each SWE_Block w.r.t. the simulation domain
     // (particularly not the original scenario domain, which might be finer in resolution)
@@ -212,16 +258,22 @@ int main(int argc, char **argv) {
     boundaries[BND_TOP] = (localBlockPositionY < blockCountY - 1) ? CONNECT : scenario.getBoundaryType(BND_TOP);
 
     // Initialize the simulation block according to the scenario
-    SWE_DimensionalSplittingMpi simulation(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY,
-                                           localTimestepping);
+    SWE_MpiBlock simulation(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY,
+                            localTimestepping, cartesianComm);
     simulation.initScenario(scenario, boundaries);
+#if defined(ASYNCHRONOUS_COMMUNICATION)
+    if (args.isSet("progress-interval"))
+        simulation.setProgressInterval(args.getArgument<int>("progress-interval"));
+#endif // ASYNCHRONOUS_COMMUNICATION
 
     // calculate neighbours to the current ranks simulation block
     int myNeighbours[4];
-    myNeighbours[BND_LEFT] = (localBlockPositionX > 0) ? myMpiRank - blockCountY : -1;
-    myNeighbours[BND_RIGHT] = (localBlockPositionX < blockCountX - 1) ? myMpiRank + blockCountY : -1;
-    myNeighbours[BND_BOTTOM] = (localBlockPositionY > 0) ? myMpiRank - 1 : -1;
-    myNeighbours[BND_TOP] = (localBlockPositionY < blockCountY - 1) ? myMpiRank + 1 : -1;
+    MPI_Cart_shift(cartesianComm, 0, 1, &myNeighbours[BND_LEFT], &myNeighbours[BND_RIGHT]);
+    MPI_Cart_shift(cartesianComm, 1, 1, &myNeighbours[BND_BOTTOM], &myNeighbours[BND_TOP]);
+    for (int border = 0; border < 4; border++) {
+        if (myNeighbours[border] == MPI_PROC_NULL)
+            myNeighbours[border] = -1;
+    }
 
 
     simulation.connectNeighbours(myNeighbours);
@@ -234,6 +286,8 @@ int main(int argc, char **argv) {
      ***************/
     // Initialize boundary size of the ghost layers
     NetCdfWriter *writer;
+    // The writers keep a reference to the bathymetry, compact storage is converted once
+    const Float2D &outputBathymetry = toFloat2D(simulation.getBathymetry());
 if(write){
     BoundarySize boundarySize = {{1, 1, 1, 1}};
     //outputFileName = generateBaseFileName(outputBaseName, localBlockPositionX, localBlockPositionY);
@@ -242,7 +296,7 @@ if(write){
     // Construct a netCDF writer
     writer = new NetCdfWriter(
             outputFileName,
-            simulation.getBathymetry(),
+            outputBathymetry,
             boundarySize,
             nxLocal,
             nyLocal,
@@ -254,7 +308,7 @@ if(write){
     // Construct a vtk writer
     VtkWriter writer(
             outputFileName,
-            simulation.getBathymetry(),
+            outputBathymetry,
             boundarySize,
             nxLocal,
             nyLocal,
@@ -267,9 +321,9 @@ if(write){
 
     // Write the output at t = 0
     if (write) {
-        writer->writeTimeStep(simulation.getWaterHeight(),
-                             simulation.getMomentumHorizontal(),
-                             simulation.getMomentumVertical(),
+        writer->writeTimeStep(toFloat2D(simulation.getWaterHeight()),
+                             toFloat2D(simulation.getMomentumHorizontal()),
+                             toFloat2D(simulation.getMomentumVertical()),
                              (float) 0.);
     }
 
@@ -292,7 +346,7 @@ if(write){
 
     // Initialize wall timer
 
-    float t = 0.0;
+    TimeScalar t = 0.;
 
     float timestep;
 
@@ -303,17 +357,33 @@ if(write){
             do {
                 // Start measurement
                 CollectorMpi::getInstance().startCounter(CollectorMpi::CTR_WALL);
+#if defined(OVERLAP_EXCHANGE)
+                // The exchange is finished in computeNumericalFluxes() after the interior edges have been computed.
+                // With local timestepping, the ghost layers decide whether the block computes at all.
+                if (localTimestepping)
+                    simulation.setGhostLayer();
+                else
+                    simulation.startGhostLayerExchange();
+#else
                 // this is an implicit block (mpi recv in setGhostLayer()
                 simulation.setGhostLayer();
+#endif
 
                 // compute numerical flux on each edge
                 simulation.computeNumericalFluxes();
 
+#if defined(NONBLOCKING_REDUCTION)
+                // update the cell values, the block completes the reduction of its timestep in updateUnknowns()
+                simulation.updateUnknowns(simulation.getMaxTimestep());
+
+                timestep = simulation.getMaxTimestep();
+#else
                 // max timestep has been reduced over all ranks in computeNumericalFluxes()
                 timestep = simulation.getMaxTimestep();
 
                 // update the cell values
                 simulation.updateUnknowns(timestep);
+#endif
 
                 // Accumulate wall time
                 CollectorMpi::getInstance().stopCounter(CollectorMpi::CTR_WALL);
@@ -334,9 +404,9 @@ if(write){
         if (write) {
             // write output
             writer->writeTimeStep(
-                    simulation.getWaterHeight(),
-                    simulation.getMomentumHorizontal(),
-                    simulation.getMomentumVertical(),
+                    toFloat2D(simulation.getWaterHeight()),
+                    toFloat2D(simulation.getMomentumHorizontal()),
+                    toFloat2D(simulation.getMomentumVertical()),
                     t);
         }
 
@@ -355,6 +425,7 @@ if(write){
     CollectorMpi::getInstance().setRank(myMpiRank);
     CollectorMpi::getInstance().logResults();
     simulation.freeMpiType();
+    MPI_Comm_free(&cartesianComm);
     if (write)
         delete writer;
 
@@ -70,6 +70,8 @@ int main(int argc, char** argv) {
     args.addOption("write", 'w', "Write results", tools::Args::Required, false);
     //args.addOption("iteration-count", 'i', "Iteration Count (Overrides t and n)", tools::Args::Required, false);
     args.addOption("local-timestepping", 'l', "Activate local timestepping", tools::Args::Required, false);
+    args.addOption("progress-interval", 'g', "Columns computed between two tests of the outstanding sends, 0 disables the tests (default: 0)",
+                   tools::Args::Required, false);
     // Parse command line arguments
     tools::Args::Result ret = args.parse(argc, argv);
     switch (ret) {
@@ -215,11 +217,13 @@ int main(int argc, char** argv) {
             }
         }
         simulationBlocks[i - startPoint]->initScenario(scenario, boundaries.data());
+        simulationBlocks[i - startPoint]->setRank(myRank);
         simulationBlocks[i - startPoint]->connectNeighbourLocalities(refinedNeighbours);
         simulationBlocks[i - startPoint]->connectNeighbours(realNeighbours);
         simulationBlocks[i - startPoint]->connectLocalNeighbours(neighbourBlocks);
-        simulationBlocks[i - startPoint]->setRank(myRank);
         simulationBlocks[i - startPoint]->setDuration(simulationDuration);
+        if (args.isSet("progress-interval"))
+            simulationBlocks[i - startPoint]->setProgressInterval(args.getArgument<int>("progress-interval"));
        //std::cout << myRank <<"| " << realNeighbours[0] << " " << realNeighbours[1] << " " << realNeighbours[2] << " " << realNeighbours[3] << std::endl;
 
     }
@@ -246,7 +250,7 @@ int main(int argc, char** argv) {
 
 
 
-    float t = 0.;
+    TimeScalar t = 0.;
     bool synchronizedTimestep = true;
 
     float timestep;
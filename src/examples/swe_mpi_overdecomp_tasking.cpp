@@ -13,6 +13,7 @@
 
 #include <mpi.h>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include "tools/args.hh"
 #include <limits.h>
@@ -70,6 +71,8 @@ int main(int argc, char** argv) {
     args.addOption("write", 'w', "Write results", tools::Args::Required, false);
     //args.addOption("iteration-count", 'i', "Iteration Count (Overrides t and n)", tools::Args::Required, false);
     args.addOption("local-timestepping", 'l', "Activate local timestepping", tools::Args::Required, false);
+    args.addOption("progress-interval", 'g', "Columns computed between two tests of the outstanding sends, 0 disables the tests (default: 0)",
+                   tools::Args::Required, false);
     // Parse command line arguments
     tools::Args::Result ret = args.parse(argc, argv);
     switch (ret) {
@@ -186,6 +189,9 @@ int main(int argc, char** argv) {
         //simulationBlocks[i - startPoint]->initScenario(scenario, boundaries.data());
     }
 
+    // On-rank neighbours of each block by Boundary, the block itself where there is none
+    std::vector<std::array<int, 4>> localNeighbours(ranksPerLocality);
+
     for (int i = startPoint; i < startPoint + ranksPerLocality; i++) {
         auto myRank = i;
         int localBlockPositionX = myRank / blockCountY;
@@ -213,13 +219,17 @@ int main(int argc, char** argv) {
                 refinedNeighbours[j] = myNeighbours[j] / ranksPerLocality;
                 boundaries[j] = CONNECT;
             }
+            localNeighbours[i - startPoint][j] =
+                    boundaries[j] == CONNECT_WITHIN_RANK ? myNeighbours[j] - startPoint : i - startPoint;
         }
         simulationBlocks[i - startPoint]->initScenario(scenario, boundaries.data());
+        simulationBlocks[i - startPoint]->setRank(myRank);
         simulationBlocks[i - startPoint]->connectNeighbourLocalities(refinedNeighbours);
         simulationBlocks[i - startPoint]->connectNeighbours(realNeighbours);
         simulationBlocks[i - startPoint]->connectLocalNeighbours(neighbourBlocks);
-        simulationBlocks[i - startPoint]->setRank(myRank);
         simulationBlocks[i - startPoint]->setDuration(simulationDuration);
+        if (args.isSet("progress-interval"))
+            simulationBlocks[i - startPoint]->setProgressInterval(args.getArgument<int>("progress-interval"));
        //std::cout << myRank <<"| " << realNeighbours[0] << " " << realNeighbours[1] << " " << realNeighbours[2] << " " << realNeighbours[3] << std::endl;
 
     }
@@ -246,8 +256,7 @@ int main(int argc, char** argv) {
 
 
 
-    float t = 0.;
-    bool synchronizedTimestep = true;
+    TimeScalar t = 0.;
 
     float timestep;
 
@@ -257,110 +266,197 @@ int main(int argc, char** argv) {
         }
     }
 
+    /*
+     * Task dependencies, all tasks are created by one thread:
+     *  - blockProxies order the tasks of a block, which share its state
+     *  - cellProxies order the updates of a block after the reads of its cells by the on-rank neighbours:
+     *    setGhostLayer() copies their ghost layers from them, and with global timestepping
+     *    the x-sweep reads the edge columns in place (see SWE_DimensionalSplittingMPIOverdecomp)
+     *  - haloProxies, per block and Boundary, order the fluxes after the tasks which provide the ghost layer:
+     *    setGhostLayer() for on-rank neighbours and domain boundaries, or starts receiving it from another
+     *    locality, then the receive completes it (with local timestepping, it also copies or interpolates)
+     * The depend clauses list the four Boundaries one by one: GCC allocates the dependencies of iterators
+     * on the stack of the creating thread, which does not return while it schedules a timestep.
+     * The pointers are only read by depend clauses, which GCC does not count as a use.
+     */
     auto blockProxies = std::make_unique<int[]>(simulationBlocks.size());
-    int *blockProxyPtrs = blockProxies.get();
+    [[gnu::unused]] int *blockProxyPtrs = blockProxies.get();
+    auto cellProxies = std::make_unique<int[]>(simulationBlocks.size());
+    [[gnu::unused]] int *cellProxyPtrs = cellProxies.get();
+    auto haloProxies = std::make_unique<int[][4]>(simulationBlocks.size());
+    [[gnu::unused]] int (*haloProxyPtrs)[4] = haloProxies.get();
+
+#if defined(SHARED_EDGE_COLUMNS)
+    bool sweepReadsNeighbours = !localTimestepping;
+#else
+    bool sweepReadsNeighbours = false;
+#endif
+
+    /*
+     * The receives are not waited for in a task, a blocked thread could hold back the sends
+     * the neighbouring localities wait for. The thread creating the tasks tests them instead,
+     * and creates the tasks of a block one stage after the other:
+     *  - EXCHANGE: once the sends of the last exchange have completed, set the ghost layers and start the receives
+     *  - RECEIVE: once they have been received, process them and compute the fluxes (and update)
+     *  - COMPUTE: with local timestepping, once the block has been updated, it continues with its next
+     *    local timestep unless it has reached the maximum local timestep
+     *  - LAST_SEND: it sends the ghost layers of the maximum local timestep, if other blocks still compute
+     * completedTasks tells it when the tasks of the last stage have completed.
+     * If it cannot create any tasks, it executes them until a block completes its stage.
+     */
+    enum BlockStage { EXCHANGE, RECEIVE, COMPUTE, LAST_SEND, DONE };
+    std::vector<BlockStage> stages(simulationBlocks.size());
+    std::unique_ptr<std::atomic<bool>[]> completedTasks(new std::atomic<bool>[simulationBlocks.size()]);
+    for (int i = 0; i < simulationBlocks.size(); i++) completedTasks[i] = true;
 
     CollectorChameleon collector;
     // loop over the count of requested
 
+#pragma omp parallel
+#pragma omp single
     for (int i = 0; i < numberOfCheckPoints; i++) {
         // Simulate until the checkpoint is reached
         while (t < checkpointInstantOfTime[i]) {
             collector.startCounter(CollectorChameleon::CTR_WALL);
-            #pragma omp parallel
-            {
-            do {
-            //#pragma omp parallel
-            //{
-                  //#pragma omp taskwait
-                  //#pragma omp barrier
-
-#pragma omp for 
-                for (int i = 0; i < simulationBlocks.size(); i++){
-                       // std::cout << i << " set" << std::endl;
-//#pragma omp task depend(out:blockProxyPtrs[i])
-                        simulationBlocks[i]->setGhostLayer();
-                    }
- //                 #pragma omp taskwait
- //                 #pragma omp barrier                   
-
-		//nowait (?)
-#pragma omp for 
-                    for (int i = 0; i < simulationBlocks.size(); i++){
-//#pragma omp task depend(inout:blockProxyPtrs[i])
-                        simulationBlocks[i]->receiveGhostLayer();
+
+            // Blocks which have not computed their fluxes (global timestepping)
+            // or not reached the maximum local timestep (local timestepping)
+            int pendingBlocks = simulationBlocks.size();
+            for (auto &stage: stages) stage = EXCHANGE;
+
+            while (pendingBlocks > 0) {
+                bool createdTasks = false;
+                int busyBlock = -1;
+                for (int i = 0; i < simulationBlocks.size(); i++) {
+                    if (!completedTasks[i]) {
+                        busyBlock = i;
+                        continue;
                     }
-//todo: nowait?
-#pragma omp for nowait
-                    for (int i = 0; i < simulationBlocks.size(); i++){
-#pragma omp task depend(inout:blockProxyPtrs[i]) firstprivate(i) 
-                        simulationBlocks[i]->computeNumericalFluxes();
+                    switch (stages[i]) {
+                        case EXCHANGE:
+                            if (!simulationBlocks[i]->testSendGhostLayer()) break;
+                            completedTasks[i] = false;
+                            createdTasks = true;
+#pragma omp task depend(in: cellProxyPtrs[localNeighbours[i][BND_LEFT]], cellProxyPtrs[localNeighbours[i][BND_RIGHT]], \
+                           cellProxyPtrs[localNeighbours[i][BND_BOTTOM]], cellProxyPtrs[localNeighbours[i][BND_TOP]]) \
+                 depend(out: haloProxyPtrs[i][BND_LEFT], haloProxyPtrs[i][BND_RIGHT], \
+                             haloProxyPtrs[i][BND_BOTTOM], haloProxyPtrs[i][BND_TOP]) \
+                 depend(inout: blockProxyPtrs[i]) firstprivate(i)
+                            {
+                                simulationBlocks[i]->setGhostLayer();
+                                simulationBlocks[i]->startReceiveGhostLayer();
+                                completedTasks[i] = true;
+                            }
+                            stages[i] = RECEIVE;
+                            break;
+                        case RECEIVE: {
+                            if (!simulationBlocks[i]->testReceiveGhostLayer()) break;
+                            completedTasks[i] = false;
+                            createdTasks = true;
+                            int sweepLeft = sweepReadsNeighbours ? localNeighbours[i][BND_LEFT] : i;
+                            int sweepRight = sweepReadsNeighbours ? localNeighbours[i][BND_RIGHT] : i;
+                            // With local timestepping, this changes the time of the block the on-rank neighbours copy
+#pragma omp task depend(inout: haloProxyPtrs[i][BND_LEFT], haloProxyPtrs[i][BND_RIGHT], \
+                               haloProxyPtrs[i][BND_BOTTOM], haloProxyPtrs[i][BND_TOP]) \
+                 depend(inout: blockProxyPtrs[i], cellProxyPtrs[i]) firstprivate(i)
+                            simulationBlocks[i]->finishReceiveGhostLayer();
+#pragma omp task depend(in: haloProxyPtrs[i][BND_LEFT], haloProxyPtrs[i][BND_RIGHT], \
+                            haloProxyPtrs[i][BND_BOTTOM], haloProxyPtrs[i][BND_TOP]) \
+                 depend(in: cellProxyPtrs[sweepLeft], cellProxyPtrs[sweepRight]) \
+                 depend(inout: blockProxyPtrs[i]) firstprivate(i)
+                            {
+                                simulationBlocks[i]->computeNumericalFluxes();
+                                if (!localTimestepping)
+                                    completedTasks[i] = true;
+                                else if (simulationBlocks[i]->allGhostlayersInSync())
+                                    simulationBlocks[i]->maxTimestep = simulationBlocks[i]->getRoundTimestep(simulationBlocks[i]->maxTimestep);
+                            }
+                            if (localTimestepping) {
+#pragma omp task depend(inout: blockProxyPtrs[i], cellProxyPtrs[i]) firstprivate(i)
+                                {
+                                    simulationBlocks[i]->updateUnknowns(timestep);
+                                    completedTasks[i] = true;
+                                }
+                                stages[i] = COMPUTE;
+                            } else {
+                                // The timestep is reduced over all blocks first
+                                pendingBlocks--;
+                                stages[i] = DONE;
+                            }
+                            break;
+                        }
+                        case COMPUTE:
+                            if (!simulationBlocks[i]->hasMaxLocalTimestep()) {
+                                stages[i] = EXCHANGE;
+                                break;
+                            }
+                            pendingBlocks--;
+                            stages[i] = pendingBlocks > 0 ? LAST_SEND : DONE;
+                            break;
+                        case LAST_SEND:
+                            // The neighbouring localities may wait for these ghost layers to reach the end of the timestep
+                            // themselves, the next timestep only sends them once all blocks of this locality have reached it
+                            if (pendingBlocks == 0) {
+                                stages[i] = DONE;
+                                break;
+                            }
+                            if (!simulationBlocks[i]->testSendGhostLayer()) break;
+                            completedTasks[i] = false;
+                            createdTasks = true;
+#pragma omp task depend(in: cellProxyPtrs[localNeighbours[i][BND_LEFT]], cellProxyPtrs[localNeighbours[i][BND_RIGHT]], \
+                           cellProxyPtrs[localNeighbours[i][BND_BOTTOM]], cellProxyPtrs[localNeighbours[i][BND_TOP]]) \
+                 depend(inout: blockProxyPtrs[i]) firstprivate(i)
+                            {
+                                simulationBlocks[i]->setGhostLayer();
+                                completedTasks[i] = true;
+                            }
+                            stages[i] = DONE;
+                            break;
+                        case DONE:
+                            break;
                     }
-                
-                if (!localTimestepping) {
-#pragma omp barrier
                 }
+                if (!createdTasks && busyBlock >= 0) {
+#pragma omp taskwait depend(in: blockProxyPtrs[busyBlock])
+                }
+            }
 
-//#pragma omp master 
-//                {
-                    if (!localTimestepping) {
-                        collector.startCounter(CollectorChameleon::CTR_REDUCE);
-                        timesteps.clear();
-                        for (auto &block: simulationBlocks)timesteps.push_back(block->maxTimestep);
-
-                        float minTimestep = *std::min_element(timesteps.begin(), timesteps.end());
-                        MPI_Allreduce(&minTimestep, &timestep, 1, MPI_FLOAT, MPI_MIN, MPI_COMM_WORLD);
-
-                        for (auto &block: simulationBlocks)block->maxTimestep = timestep;
-                        collector.stopCounter(CollectorChameleon::CTR_REDUCE);
-                        //std::cout << "timestep " << timestep << std::endl;
-                    } else {
-                       // for (auto &block: simulationBlocks){
-                       //todo: nowait ?
-                       #pragma omp for
-                       for (int i = 0; i < simulationBlocks.size(); i++){
-   #pragma omp task depend(inout:blockProxyPtrs[i]) firstprivate(i) 
-                            if(simulationBlocks[i]->allGhostlayersInSync()){
-                                simulationBlocks[i]->maxTimestep = simulationBlocks[i]->getRoundTimestep(simulationBlocks[i]->maxTimestep);
-                            }
-                        }
+            if (!localTimestepping) {
+                // The fluxes of all blocks are needed for the timestep
+#pragma omp taskwait
+                collector.startCounter(CollectorChameleon::CTR_REDUCE);
+                timesteps.clear();
+                for (auto &block: simulationBlocks)timesteps.push_back(block->maxTimestep);
 
-                    }
-                //}
+                float minTimestep = *std::min_element(timesteps.begin(), timesteps.end());
+                MPI_Allreduce(&minTimestep, &timestep, 1, MPI_FLOAT, MPI_MIN, MPI_COMM_WORLD);
+
+                for (auto &block: simulationBlocks)block->maxTimestep = timestep;
+                collector.stopCounter(CollectorChameleon::CTR_REDUCE);
 
-#pragma omp for  
-                    for (int i = 0; i < simulationBlocks.size(); i++){
-#pragma omp task depend(inout:blockProxyPtrs[i]) firstprivate(i) 
+                // The blocks start the next timestep as soon as they have been updated
+                for (int i = 0; i < simulationBlocks.size(); i++) {
+                    completedTasks[i] = false;
+#pragma omp task depend(inout: blockProxyPtrs[i], cellProxyPtrs[i]) firstprivate(i)
+                    {
                         simulationBlocks[i]->updateUnknowns(timestep);
-                    }
-                
-
-#pragma omp master 
-{
-                if (localTimestepping) {
-                    //if each block got the maxLocalTimestep the timestep is finished
-                    synchronizedTimestep = true;
-                    for (auto &block : simulationBlocks) {
-                        if (!block->hasMaxLocalTimestep()) {
-                            synchronizedTimestep = false;
-                        }
+                        completedTasks[i] = true;
                     }
                 }
-}
-        //Todo: can we get rid of this?
-            #pragma omp barrier  
-             // }
-            } while (localTimestepping && !synchronizedTimestep);
-            // update simulation time with time step width.
+            } else {
+                // All blocks have reached the end of the timestep
+#pragma omp taskwait
             }
             collector.stopCounter(CollectorChameleon::CTR_WALL);
 
+            // update simulation time with time step width.
             t += localTimestepping ? maxLocalTimestep : timestep;
             if(localTimestepping){
                 for (auto &block: simulationBlocks)block->resetStepSizeCounter();
             }
         }
 
+#pragma omp taskwait
         if (localityRank == 0) {
             printf("Write timestep (%fs)\n", t);
         }
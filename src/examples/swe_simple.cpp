@@ -74,6 +74,7 @@ int main(int argc, char **argv) {
     args.addOption("resolution-horizontal", 'x', "Number of simulation cells in horizontal direction");
     args.addOption("resolution-vertical", 'y', "Number of simulated cells in y-direction");
     args.addOption("output-basepath", 'o', "Output base file name");
+    args.addOption("tile-size", 's', "Edge length of the cache tiles in cells (0 disables tiling)", tools::Args::Required, false);
 
 
     // Declare the variables needed to hold command line input
@@ -81,11 +82,12 @@ int main(int argc, char **argv) {
     int numberOfCheckPoints;
     int nxRequested;
     int nyRequested;
+    int tileSize = 0;
     std::string outputBaseName;
 
     // Declare variables for the output and the simulation time
     std::string outputFileName;
-    float t = 0.;
+    TimeScalar t = 0.;
 
     // Parse command line arguments
     tools::Args::Result ret = args.parse(argc, argv);
@@ -104,6 +106,9 @@ int main(int argc, char **argv) {
     nxRequested = args.getArgument<int>("resolution-horizontal");
     nyRequested = args.getArgument<int>("resolution-vertical");
     outputBaseName = args.getArgument<std::string>("output-basepath");
+    if (args.isSet("tile-size")) {
+        tileSize = args.getArgument<int>("tile-size");
+    }
 
     // Initialize Scenario
 #ifdef ASAGI
@@ -147,7 +152,7 @@ int main(int argc, char **argv) {
     boundaries[BND_BOTTOM] = scenario.getBoundaryType(BND_BOTTOM);
     boundaries[BND_TOP] = scenario.getBoundaryType(BND_TOP);
 
-    SWE_DimensionalSplitting simulation(nxRequested, nyRequested, dxSimulation, dySimulation, originX, originY);
+    SWE_DimensionalSplitting simulation(nxRequested, nyRequested, dxSimulation, dySimulation, originX, originY, tileSize);
     simulation.initScenario(scenario, boundaries);
 
 
@@ -159,11 +164,13 @@ int main(int argc, char **argv) {
     // Initialize boundary size of the ghost layers
     BoundarySize boundarySize = {{1, 1, 1, 1}};
     outputFileName = outputBaseName;
+    // The writers keep a reference to the bathymetry, the tiled layout is converted once
+    const Float2D &outputBathymetry = toFloat2D(simulation.getBathymetry());
 #ifdef WRITENETCDF
     // Construct a netCDF writer
     NetCdfWriter writer(
             outputFileName,
-            simulation.getBathymetry(),
+            outputBathymetry,
             boundarySize,
             nxRequested,
             nyRequested,
@@ -175,7 +182,7 @@ int main(int argc, char **argv) {
     // Construct a vtk writer
     VtkWriter writer(
             outputFileName,
-            simulation.getBathymetry(),
+            outputBathymetry,
             boundarySize,
             nxRequested,
             nyRequested,
@@ -185,9 +192,9 @@ int main(int argc, char **argv) {
 
     // Write the output at t = 0
     writer.writeTimeStep(
-            simulation.getWaterHeight(),
-            simulation.getMomentumHorizontal(),
-            simulation.getMomentumVertical(),
+            toFloat2D(simulation.getWaterHeight()),
+            toFloat2D(simulation.getMomentumHorizontal()),
+            toFloat2D(simulation.getMomentumVertical()),
             (float) 0.);
 
 
@@ -255,9 +262,9 @@ int main(int argc, char **argv) {
 
         // write output
         writer.writeTimeStep(
-                simulation.getWaterHeight(),
-                simulation.getMomentumHorizontal(),
-                simulation.getMomentumVertical(),
+                toFloat2D(simulation.getWaterHeight()),
+                toFloat2D(simulation.getMomentumHorizontal()),
+                toFloat2D(simulation.getMomentumVertical()),
                 t);
     }
 
@@ -91,7 +91,7 @@ int main(int argc, char **argv) {
     bool write = false;
     // Declare variables for the output and the simulation time
     std::string outputFileName;
-    float t = 0.;
+    TimeScalar t = 0.;
 
     // Parse command line arguments
     tools::Args::Result ret = args.parse(argc, argv);
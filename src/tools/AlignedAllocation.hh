@@ -0,0 +1,87 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Allocation policy of the 2D arrays.
+ *
+ * Arrays are aligned to a cache line and initialized to zero on allocation.
+ * With PARALLEL_FIRST_TOUCH the initialization is distributed over the OpenMP threads with a static schedule,
+ * the same contiguous partition of the columns a static (collapsed) loop over the array uses,
+ * so the pages are placed on the NUMA node of the thread that computes them.
+ * With PADDED_COLUMNS the distance between two columns is rounded up to a multiple of the cache line,
+ * so every column starts on a cache line boundary.
+ */
+
+#ifndef __ALIGNEDALLOCATION_HH
+#define __ALIGNEDALLOCATION_HH
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace tools {
+
+const int cacheLineSize = 64;
+
+/**
+ * Distance between two columns of rows elements of type S.
+ */
+template<typename S>
+int columnStride(int rows) {
+#if defined(PADDED_COLUMNS)
+    const int elementsPerLine = cacheLineSize / sizeof(S) > 0 ? cacheLineSize / sizeof(S) : 1;
+    return (rows + elementsPerLine - 1) / elementsPerLine * elementsPerLine;
+#else
+    return rows;
+#endif
+}
+
+/**
+ * Initializes size elements to zero, this is the first touch of the memory.
+ */
+template<typename S>
+void initializeArray(S *data, long size) {
+#if defined(PARALLEL_FIRST_TOUCH)
+#pragma omp parallel for schedule(static)
+#endif
+    for (long k = 0; k < size; k++) {
+        new(data + k) S(0);
+    }
+}
+
+/**
+ * Allocates size elements aligned to a cache line, initialized to zero.
+ */
+template<typename S>
+std::shared_ptr<S> allocateArray(long size) {
+    void *memory = nullptr;
+    if (posix_memalign(&memory, cacheLineSize, (size > 0 ? size : 1) * sizeof(S)) != 0)
+        throw std::bad_alloc();
+
+    S *data = static_cast<S *>(memory);
+    initializeArray(data, size);
+
+    // All storage types are trivially destructible
+    return std::shared_ptr<S>(data, [](S *pointer) { free(pointer); });
+}
+
+} // namespace tools
+
+#endif // __ALIGNEDALLOCATION_HH
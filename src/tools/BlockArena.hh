@@ -0,0 +1,130 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Arena for the arrays of a block.
+ *
+ * With BLOCK_ARENA, all arrays of a block are carved consecutively from one contiguous region,
+ * each starting on a cache line. The region is reserved with mmap and only backed by memory on first touch,
+ * so the reservation can be generous. Large regions are advised to use transparent huge pages.
+ * Every array keeps the region alive, the whole region is released with a single munmap
+ * when the last array of the block is destroyed.
+ * Arrays which do not fit into the region anymore are allocated separately.
+ *
+ * Without BLOCK_ARENA, every array is a separate allocation (see tools/AlignedAllocation.hh).
+ */
+
+#ifndef __BLOCKARENA_HH
+#define __BLOCKARENA_HH
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#if defined(BLOCK_ARENA)
+#include <sys/mman.h>
+#endif
+
+#include "tools/AlignedAllocation.hh"
+
+namespace tools {
+
+class BlockArena {
+public:
+    BlockArena() {}
+
+    /**
+     * @param cols, rows size of the largest array of the block
+     * @param arrayCount number of arrays the region is reserved for
+     */
+    BlockArena(int cols, int rows, int arrayCount = 24) {
+#if defined(BLOCK_ARENA)
+        // Reserved for the largest storage type, so no storage type runs out of space
+        const size_t arrayBytes = (size_t) cols * (rows + cacheLineSize) * sizeof(double) + cacheLineSize;
+        const size_t size = (arrayBytes * arrayCount + hugePageSize - 1) / hugePageSize * hugePageSize;
+
+        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory == MAP_FAILED)
+            throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+        // A huge page is only worth it if most of it is used
+        if (size >= 8 * hugePageSize)
+            madvise(memory, size, MADV_HUGEPAGE);
+#endif
+        region = std::make_shared<Region>(static_cast<char *>(memory), size);
+#endif
+    }
+
+    /**
+     * Allocates size elements, initialized to zero.
+     */
+    template<typename S>
+    std::shared_ptr<S> allocate(long size) {
+#if defined(BLOCK_ARENA)
+        const size_t bytes = (size > 0 ? size : 1) * sizeof(S);
+        const size_t alignedBytes = (bytes + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+        if (region && region->used + alignedBytes <= region->size) {
+            S *data = reinterpret_cast<S *>(region->memory + region->used);
+            region->used += alignedBytes;
+            initializeArray(data, size);
+
+            // Shares the ownership of the region
+            return std::shared_ptr<S>(region, data);
+        }
+#endif
+        return allocateArray<S>(size);
+    }
+
+    /**
+     * Start of the region and number of bytes carved from it, arrays allocated in the same order
+     * from two arenas of the same size are at the same offsets.
+     */
+    char *getBase() const {
+        return region ? region->memory : nullptr;
+    }
+
+    size_t getUsedBytes() const {
+        return region ? region->used : 0;
+    }
+
+private:
+    static const size_t hugePageSize = 2 * 1024 * 1024;
+
+    struct Region {
+        Region(char *memory, size_t size) :
+                memory(memory), size(size), used(0) {}
+
+        ~Region() {
+#if defined(BLOCK_ARENA)
+            munmap(memory, size);
+#endif
+        }
+
+        char *memory;
+        size_t size;
+        size_t used;
+    };
+
+    std::shared_ptr<Region> region;
+};
+
+} // namespace tools
+
+#endif // __BLOCKARENA_HH
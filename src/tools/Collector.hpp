@@ -23,13 +23,15 @@ public:
     double group_flop_ctr;
     bool is_master;
     std::string log_name;
-    std::array<std::chrono::duration<double>, 4> total_ctrs;
-    std::array<double, 4> result_ctrs;
-    std::array<std::chrono::steady_clock::time_point, 4> measure_ctrs;
+    std::array<std::chrono::duration<double>, 5> total_ctrs;
+    std::array<double, 5> result_ctrs;
+    std::array<std::chrono::steady_clock::time_point, 5> measure_ctrs;
     std::vector<float> timesteps;
 public:
     enum COUNTERS {
-        CTR_EXCHANGE, CTR_BARRIER, CTR_REDUCE, CTR_WALL
+        CTR_EXCHANGE, CTR_BARRIER, CTR_REDUCE, CTR_WALL,
+        // Time computing while the exchange was in flight, until the ghost layers were found complete
+        CTR_HIDDEN_EXCHANGE
     };
 
     Collector &operator+=(const Collector &other) {
@@ -38,7 +40,8 @@ public:
             total_ctrs[i] += other.total_ctrs[i];
 
         }
-        for(int i=0; i< 4; i++)  measure_ctrs[i] = other.measure_ctrs[i];
+        total_ctrs[CTR_HIDDEN_EXCHANGE] += other.total_ctrs[CTR_HIDDEN_EXCHANGE];
+        for(int i=0; i< 5; i++)  measure_ctrs[i] = other.measure_ctrs[i];
         total_ctrs[CTR_WALL] = std::min(total_ctrs[CTR_WALL],
                                         other.total_ctrs[CTR_WALL]); //so we dont add WALL time together
         timesteps.insert( timesteps.end(), other.timesteps.begin(), other.timesteps.end() );
@@ -95,6 +98,14 @@ public:
                   << "Communication Time: " << result_ctrs[CTR_EXCHANGE] << "s" << std::endl
                   << "Reduction Time: " << result_ctrs[CTR_REDUCE] << "s" << std::endl
                   << "Timesteps Min: " << (timesteps.size()>0?*timestepMinMax.first:0) << " Max: " << (timesteps.size()>0?*timestepMinMax.second:0) << " Average: "<< timestepAvg << std::endl;
+        // Only measured by blocks overlapping the exchange with computation
+        if (result_ctrs[CTR_HIDDEN_EXCHANGE] > 0) {
+            // Share of the exchange time (hidden and waited for) that was overlapped with computation
+            double hiddenFraction = result_ctrs[CTR_HIDDEN_EXCHANGE] /
+                                    (result_ctrs[CTR_HIDDEN_EXCHANGE] + result_ctrs[CTR_EXCHANGE]);
+            std::cout << "Hidden Communication Time: " << result_ctrs[CTR_HIDDEN_EXCHANGE] << "s" << std::endl
+                      << "Hidden Communication Fraction: " << 100. * hiddenFraction << "%" << std::endl;
+        }
     }
 
     virtual void collect() = 0;
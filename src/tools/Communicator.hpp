@@ -100,12 +100,12 @@ struct communicator {
 
     hpx::future<void>
     get_remote(Boundary n, int nx, int ny, Float2DBuffer *h, Float2DBuffer *hu, Float2DBuffer *hv, Float2DNative *b,
-               float *borderTimestep, bool bat) {
+               TimeScalar *borderTimestep, bool bat) {
 
         return hpx::dataflow(
                 hpx::util::unwrapping(
                         [](T border, Boundary n, int nx, int ny, Float2DBuffer *h, Float2DBuffer *hu, Float2DBuffer *hv,
-                           Float2DNative *b, float *borderTimestep, bool bat) -> void {
+                           Float2DNative *b, TimeScalar *borderTimestep, bool bat) -> void {
                             if (n == BND_LEFT) {
                                 borderTimestep[BND_LEFT] = border.timestep;
                                 if (!bat) {
@@ -192,7 +192,7 @@ struct communicator {
 
     hpx::future<void>
     get_local(Boundary n, int nx, int ny, Float2DBuffer *h, Float2DBuffer *hu, Float2DBuffer *hv, Float2DNative *b,
-              float *borderTimestep, bool bat) {
+              TimeScalar *borderTimestep, bool bat) {
         if (n == BND_LEFT) {
             borderTimestep[BND_LEFT] = neighbourBlocks[n]->currentTotalLocalTimestep;
             int startIndexSender = (neighbourBlocks[n]->nx) * (ny + 2) + 1;
@@ -268,7 +268,7 @@ struct communicator {
 
     hpx::future<void>
     get(Boundary n, int nx, int ny, Float2DBuffer *h, Float2DBuffer *hu, Float2DBuffer *hv, Float2DNative *b,
-        float *borderTimestep, bool bat = false) {
+        TimeScalar *borderTimestep, bool bat = false) {
         // Get our data from our neighbor, we return a future to allow the
         // algorithm to synchronize.
 
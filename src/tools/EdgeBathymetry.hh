@@ -0,0 +1,85 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Per-edge bathymetry differences of a block.
+ *
+ * The bathymetry does not change once the scenario is initialized and the ghost layer bathymetry
+ * has been exchanged, so the differences bRight - bLeft of all edges are computed once
+ * and then passed to solver::HLLEBatch instead of the two bathymetry columns.
+ *
+ * The layout matches the batched edge columns of the blocks:
+ * vertical[i - 1] holds the ny edges between cell column i - 1 and i (rows 1..ny),
+ * horizontal[i - 1] holds the ny + 1 edges of cell column i (between rows j and j + 1, j = 0..ny).
+ */
+
+#ifndef __EDGEBATHYMETRY_HH
+#define __EDGEBATHYMETRY_HH
+
+#include "tools/Float2D.hh"
+#include "tools/Float2DNative.hh"
+
+class EdgeBathymetry {
+public:
+    EdgeBathymetry() :
+            initialized(false) {}
+
+    EdgeBathymetry(int nx, int ny) :
+            vertical(nx + 1, ny),
+            horizontal(nx, ny + 1),
+            initialized(false) {}
+
+    /**
+     * Computes the differences of all edges.
+     *
+     * @param b bathymetry including the ghost layer
+     */
+    void compute(const Float2D &b) {
+        const int nx = horizontal.getCols();
+        const int ny = vertical.getRows();
+
+        for (int i = 1; i < nx + 2; i++) {
+            for (int j = 1; j < ny + 1; j++) {
+                vertical[i - 1][j - 1] = b[i][j] - b[i - 1][j];
+            }
+        }
+        for (int i = 1; i < nx + 1; i++) {
+            for (int j = 0; j < ny + 1; j++) {
+                horizontal[i - 1][j] = b[i][j + 1] - b[i][j];
+            }
+        }
+
+        initialized = true;
+    }
+
+    bool isInitialized() const {
+        return initialized;
+    }
+
+    // bRight - bLeft of the vertical edges (x-sweep)
+    Float2DNative vertical;
+    // bAbove - bBelow of the horizontal edges (y-sweep)
+    Float2DNative horizontal;
+
+private:
+    bool initialized;
+};
+
+#endif // __EDGEBATHYMETRY_HH
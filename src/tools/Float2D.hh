@@ -22,13 +22,17 @@
  *
  *
  * @section DESCRIPTION
- * Class Float2D is a very basic helper structure to deal with 2D float arrays:
+ * Class Float2D is a very basic helper structure to deal with 2D float arrays
+ * (Float2DT is the same structure for an arbitrary storage type):
  * The storage in memory is analogous to standard arrays, this means, that sequential reads
  * incrementing the right-most index are faster than sequential reads incrementing the left-most index.
  * The difference to standard arrays is that columns are identified by first index, not the second.
  *
  * TAKE CARE: This class will free its internal memory upon destruction, regardless of any shallow copies/pointers still using it!
  *
+ * Columns are getStride() elements apart, which is larger than getRows() if the columns are padded
+ * (see tools/AlignedAllocation.hh). Raw pointer arithmetic has to use the stride.
+ *
  * EXAMPLE with symbolic addresses demonstrating access speed (cache performance)
  * Actual grid:
  *       x
@@ -53,8 +57,18 @@
 #ifndef __FLOAT2D_HH
 #define __FLOAT2D_HH
 
-class Float2D {
+#include "tools/AlignedAllocation.hh"
+
+/*
+ * The element type S is the storage type in memory. It is float for all blocks by default,
+ * compact types (see tools/HalfFloat.hh) convert to float on every access,
+ * so computations are still carried out in single precision.
+ */
+template<typename S>
+class Float2DT {
 public:
+    typedef S value_type;
+
     int getRows() const {
         return rows;
     }
@@ -63,35 +77,58 @@ public:
         return cols;
     }
 
-    float *getRawPointer() const {
+    int getStride() const {
+        return stride;
+    }
+
+    S *getRawPointer() const {
         return rawData;
     }
 
-    void setRawPointer(float *pointer) {
+    void setRawPointer(S *pointer) {
         rawData = pointer;
     }
 
-    inline float *operator[](int index) {
-        return (rawData + (rows * index));
+    inline S *operator[](int index) {
+        return (rawData + (stride * index));
     }
 
-    inline const float *operator[](int index) const {
-        return (rawData + (rows * index));
+    inline const S *operator[](int index) const {
+        return (rawData + (stride * index));
+    }
+
+    /**
+     * Position of the element [col][row] in memory, the same for all arrays with the same number of rows.
+     */
+    inline long offset(int col, int row) const {
+        return (long) stride * col + row;
+    }
+
+    inline S &at(long offset) {
+        return rawData[offset];
+    }
+
+    inline const S &at(long offset) const {
+        return rawData[offset];
     }
 
 protected:
-    Float2D() {}
+    Float2DT() {}
 
-    Float2D(int cols, int rows) :
+    Float2DT(int cols, int rows) :
             cols(cols),
-            rows(rows) {}
+            rows(rows),
+            stride(tools::columnStride<S>(rows)) {}
 
-    ~Float2D() {}
+    ~Float2DT() {}
 
     int cols;
     int rows;
+    int stride;
 
-    float *rawData;
+    S *rawData;
 };
 
+typedef Float2DT<float> Float2D;
+
 #endif // FLOAT2D_HH
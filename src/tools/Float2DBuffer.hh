@@ -10,34 +10,41 @@
 #include "tools/Float2D.hh"
 #include "tools/Float2DNative.hh"
 
-class Float2DBuffer : public Float2D {
+template<typename S>
+class Float2DBufferT : public Float2DT<S> {
 public:
-    Float2DBuffer() :
-            Float2D(0, 0) {};
+    Float2DBufferT() :
+            Float2DT<S>(0, 0) {};
 
-    Float2DBuffer(int cols, int rows, bool localTimestepping, Float2DNative &realData) :
-            Float2D(cols, rows) {
+    Float2DBufferT(int cols, int rows, bool localTimestepping, Float2DNativeT<S> &realData) :
+            Float2DBufferT(cols, rows, localTimestepping, realData, nullptr) {}
+
+    Float2DBufferT(int cols, int rows, bool localTimestepping, Float2DNativeT<S> &realData, tools::BlockArena &arena) :
+            Float2DBufferT(cols, rows, localTimestepping, realData, &arena) {}
+
+    ~Float2DBufferT() {}
+
+private:
+    Float2DBufferT(int cols, int rows, bool localTimestepping, Float2DNativeT<S> &realData, tools::BlockArena *arena) :
+            Float2DT<S>(cols, rows) {
 
         if (localTimestepping) {
 
-            std::shared_ptr<float> tmp(new float[rows * cols], std::default_delete<float[]>());
-            data = tmp;
-            rawData = data.get();
+            data = arena ? arena->allocate<S>((long) this->stride * cols)
+                         : tools::allocateArray<S>((long) this->stride * cols);
+            this->rawData = data.get();
 
         } else {
             // If there is no local timestepping buffer points to h |hu | hv
             data = realData.getPointer();
-            rawData = realData.getPointer().get();
+            this->rawData = realData.getPointer().get();
         }
 
     }
 
-    ~Float2DBuffer() {}
-
-private:
-
-
-    std::shared_ptr<float> data;
+    std::shared_ptr<S> data;
 };
 
+typedef Float2DBufferT<float> Float2DBuffer;
+
 #endif //SWE_BENCHMARK_FLOAT2DBUFFER_HH
@@ -36,6 +36,10 @@ public:
 
     }
 
+    // The buffers have to be in the shared segment, they are not allocated from the arena
+    Float2DBufferUpcxx(int cols, int rows, bool localTimestepping, Float2DUpcxx &realData, tools::BlockArena &arena) :
+            Float2DBufferUpcxx(cols, rows, localTimestepping, realData) {}
+
     ~Float2DBufferUpcxx() {}
 
     upcxx::global_ptr<float> getPointer() const {
@@ -0,0 +1,206 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Interleaved state layout: h, hu, hv and b of a cell are stored next to each other.
+ *
+ * The cells are stored column by column like Float2D, each cell holds the four components
+ * h, hu, hv and b (in this order), so one cell is 16 bytes in single precision and the solver
+ * finds all values of a cell in one cache line. A boundary column is a contiguous range of cells
+ * and a boundary row is a strided range of whole cells, so h, hu and hv of an edge can be exchanged
+ * in one message.
+ *
+ * Float2DInterleavedT is the view of one component, the first array of a block allocates the cells
+ * and the others share them (see companionArray() below). operator[] returns a column proxy,
+ * neighbouring elements of a column are components() elements apart, so there is no getRawPointer().
+ */
+
+#ifndef __FLOAT2DINTERLEAVED_HH
+#define __FLOAT2DINTERLEAVED_HH
+
+#include <memory>
+
+#include "tools/AlignedAllocation.hh"
+#include "tools/BlockArena.hh"
+#include "tools/Float2DNative.hh"
+
+template<typename S>
+class Float2DInterleavedT {
+public:
+    typedef S value_type;
+
+    // Components of a cell, the index of a component is its offset inside the cell
+    enum Component {
+        H = 0, HU = 1, HV = 2, B = 3
+    };
+    static const int components = 4;
+
+    template<typename E>
+    class Column {
+    public:
+        inline E &operator[](int row) const {
+            return column[(long) row * components];
+        }
+
+    private:
+        friend class Float2DInterleavedT;
+
+        explicit Column(E *column) :
+                column(column) {}
+
+        E *column;
+    };
+
+    Float2DInterleavedT() :
+            cols(0), rows(0), component(H), rawData(nullptr) {}
+
+    Float2DInterleavedT(int cols, int rows) :
+            cols(cols), rows(rows), component(H) {
+        cells = tools::allocateArray<S>((long) cols * rows * components);
+        rawData = cells.get();
+    }
+
+    Float2DInterleavedT(int cols, int rows, tools::BlockArena &arena) :
+            cols(cols), rows(rows), component(H) {
+        cells = arena.allocate<S>((long) cols * rows * components);
+        rawData = cells.get();
+    }
+
+    /**
+     * View of another component of the cells of other.
+     */
+    Float2DInterleavedT(const Float2DInterleavedT &other, int component) :
+            cols(other.cols), rows(other.rows), component(component),
+            cells(other.cells), rawData(other.cells.get() + component) {}
+
+    ~Float2DInterleavedT() {}
+
+    int getRows() const {
+        return rows;
+    }
+
+    int getCols() const {
+        return cols;
+    }
+
+    int getComponent() const {
+        return component;
+    }
+
+    std::shared_ptr<S> getPointer() {
+        return cells;
+    }
+
+    /**
+     * First element of the cell [col][row], i.e. its h component.
+     */
+    S *getCell(int col, int row) const {
+        return cells.get() + ((long) col * rows + row) * components;
+    }
+
+    inline Column<S> operator[](int index) {
+        return Column<S>(rawData + (long) index * rows * components);
+    }
+
+    inline Column<const S> operator[](int index) const {
+        return Column<const S>(rawData + (long) index * rows * components);
+    }
+
+protected:
+    int cols;
+    int rows;
+    int component;
+
+    std::shared_ptr<S> cells;
+    S *rawData;
+};
+
+/*
+ * Buffer for local timestepping with the interleaved layout, see Float2DBuffer.
+ * The buffers of h, hu and hv share their cells as well, so a ghost layer is received in one message.
+ */
+template<typename S>
+class Float2DInterleavedBufferT : public Float2DInterleavedT<S> {
+public:
+    Float2DInterleavedBufferT() {}
+
+    Float2DInterleavedBufferT(int cols, int rows, bool localTimestepping, Float2DInterleavedT<S> &realData,
+                              tools::BlockArena &arena) :
+            Float2DInterleavedT<S>(realData, realData.getComponent()) {
+
+        if (localTimestepping) {
+            this->cells = arena.allocate<S>((long) cols * rows * Float2DInterleavedT<S>::components);
+            this->rawData = this->cells.get() + this->component;
+        }
+        // Otherwise the buffer points to h | hu | hv
+    }
+
+    Float2DInterleavedBufferT(const Float2DInterleavedBufferT &other, int component) :
+            Float2DInterleavedT<S>(other, component) {}
+
+    ~Float2DInterleavedBufferT() {}
+};
+
+/**
+ * Column-major copy for the writers, see toFloat2D in tools/Float2DNative.hh.
+ */
+template<typename S>
+Float2DNative toFloat2D(const Float2DInterleavedT<S> &array) {
+    return tools::copyToFloat2D(array);
+}
+
+namespace tools {
+
+/**
+ * Array of a block with the same dimensions as first, used for hu, hv and b.
+ * Interleaved arrays are views of the cells of first, all other arrays are allocated separately.
+ *
+ * @param component index of the array in the cells, see Float2DInterleavedT::Component
+ */
+template<typename T>
+T companionArray(T &first, int component, BlockArena &arena) {
+    return T(first.getCols(), first.getRows(), arena);
+}
+
+template<typename S>
+Float2DInterleavedT<S> companionArray(Float2DInterleavedT<S> &first, int component, BlockArena &arena) {
+    return Float2DInterleavedT<S>(first, component);
+}
+
+/**
+ * Local timestepping buffer of realData with the same dimensions as first, used for the buffers of hu and hv.
+ */
+template<typename Buffer, typename T>
+Buffer companionBuffer(Buffer &first, int component, bool localTimestepping, T &realData, BlockArena &arena) {
+    return Buffer(first.getCols(), first.getRows(), localTimestepping, realData, arena);
+}
+
+template<typename S>
+Float2DInterleavedBufferT<S> companionBuffer(Float2DInterleavedBufferT<S> &first, int component,
+                                             bool localTimestepping, Float2DInterleavedT<S> &realData,
+                                             BlockArena &arena) {
+    if (localTimestepping)
+        return Float2DInterleavedBufferT<S>(first, component);
+    return Float2DInterleavedBufferT<S>(first.getCols(), first.getRows(), false, realData, arena);
+}
+
+} // namespace tools
+
+#endif // __FLOAT2DINTERLEAVED_HH
@@ -4,27 +4,67 @@
 #include <memory>
 
 #include "tools/Float2D.hh"
+#include "tools/BlockArena.hh"
 
-class Float2DNative : public Float2D {
+template<typename S>
+class Float2DNativeT : public Float2DT<S> {
 public:
-    Float2DNative() :
-            Float2D(0, 0) {};
-
-    Float2DNative(int cols, int rows) :
-            Float2D(cols, rows) {
-        std::shared_ptr<float> tmp(new float[rows * cols], std::default_delete<float[]>());
-        data = tmp;
-        rawData = data.get();
+    Float2DNativeT() :
+            Float2DT<S>(0, 0) {};
+
+    Float2DNativeT(int cols, int rows) :
+            Float2DT<S>(cols, rows) {
+        data = tools::allocateArray<S>((long) this->stride * cols);
+        this->rawData = data.get();
+    }
+
+    Float2DNativeT(int cols, int rows, tools::BlockArena &arena) :
+            Float2DT<S>(cols, rows) {
+        data = arena.allocate<S>((long) this->stride * cols);
+        this->rawData = data.get();
     }
 
-    ~Float2DNative() {}
+    ~Float2DNativeT() {}
 
-    std::shared_ptr<float> getPointer() {
+    std::shared_ptr<S> getPointer() {
         return data;
     }
 
 private:
-    std::shared_ptr<float> data;
+    std::shared_ptr<S> data;
 };
 
+typedef Float2DNativeT<float> Float2DNative;
+
+namespace tools {
+
+/**
+ * Column-major single precision copy of any 2D array with [col][row] accessors.
+ */
+template<typename A>
+Float2DNative copyToFloat2D(const A &array) {
+    Float2DNative result(array.getCols(), array.getRows());
+    for (int i = 0; i < array.getCols(); i++) {
+        for (int j = 0; j < array.getRows(); j++) {
+            result[i][j] = array[i][j];
+        }
+    }
+    return result;
+}
+
+}
+
+/**
+ * Single precision view of an array for the writers, which only accept Float2D.
+ * Float arrays are passed through, all other arrays are converted into a copy.
+ */
+inline const Float2D &toFloat2D(const Float2D &array) {
+    return array;
+}
+
+template<typename S>
+Float2DNative toFloat2D(const Float2DT<S> &array) {
+    return tools::copyToFloat2D(array);
+}
+
 #endif // FLOAT2DNATIVE_HH
@@ -0,0 +1,200 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * 2D array stored as an array of small tiles (AoSoA layout), an alternative to Float2DNative.
+ *
+ * The array is split into tiles of TileCols x TileRows elements. Each tile is stored contiguously,
+ * column by column like Float2D, and the tiles are stored column of tiles by column of tiles.
+ * A column of a tile (TileRows elements, one cache line of floats by default) is the unit of contiguous access,
+ * the left and right neighbours of a cell are in the same tile except at the tile boundary,
+ * so both sweeps of a tile work on a few cache lines instead of TileCols full columns.
+ *
+ * EXAMPLE with TileCols = 2, TileRows = 2, 4 x 4 elements:
+ * Memory:
+ * [0][0] [0][1] [1][0] [1][1] | [0][2] [0][3] [1][2] [1][3] | [2][0] [2][1] [3][0] [3][1] | ...
+ *
+ * The [x][y] accessors are the same as for Float2D, but operator[] returns a column proxy instead of a pointer:
+ * columns are not contiguous, so there is no getRawPointer() and no pointer arithmetic on columns.
+ * Arrays with the same number of rows share their tiling, so offset() of a cell is valid for all of them.
+ */
+
+#ifndef __FLOAT2DTILED_HH
+#define __FLOAT2DTILED_HH
+
+#include <memory>
+
+#include "tools/AlignedAllocation.hh"
+#include "tools/BlockArena.hh"
+#include "tools/Float2DNative.hh"
+
+template<typename S, int TileCols = 4, int TileRows = 16>
+class Float2DTiledT {
+    static_assert((TileCols & (TileCols - 1)) == 0 && (TileRows & (TileRows - 1)) == 0,
+                  "The tile dimensions have to be powers of two");
+
+public:
+    typedef S value_type;
+
+    static const int tileCols = TileCols;
+    static const int tileRows = TileRows;
+    static const int tileSize = TileCols * TileRows;
+
+    /**
+     * Column x of the array, the first element of the column in its first tile.
+     */
+    template<typename E>
+    class Column {
+    public:
+        inline E &operator[](int row) const {
+            return column[(long) ((unsigned) row / TileRows) * tileSize + (unsigned) row % TileRows];
+        }
+
+    private:
+        friend class Float2DTiledT;
+
+        explicit Column(E *column) :
+                column(column) {}
+
+        E *column;
+    };
+
+    Float2DTiledT() :
+            Float2DTiledT(0, 0, std::shared_ptr<S>()) {}
+
+    Float2DTiledT(int cols, int rows) :
+            Float2DTiledT(cols, rows, std::shared_ptr<S>()) {
+        data = tools::allocateArray<S>(getSize());
+        rawData = data.get();
+    }
+
+    Float2DTiledT(int cols, int rows, tools::BlockArena &arena) :
+            Float2DTiledT(cols, rows, std::shared_ptr<S>()) {
+        data = arena.allocate<S>(getSize());
+        rawData = data.get();
+    }
+
+    ~Float2DTiledT() {}
+
+    int getRows() const {
+        return rows;
+    }
+
+    int getCols() const {
+        return cols;
+    }
+
+    // Number of tiles in x- and y-direction, the last tiles may be partially used
+    int getTilesX() const {
+        return tilesX;
+    }
+
+    int getTilesY() const {
+        return tilesY;
+    }
+
+    // Number of elements including the unused elements of the last tiles
+    long getSize() const {
+        return (long) tilesX * tilesY * tileSize;
+    }
+
+    std::shared_ptr<S> getPointer() {
+        return data;
+    }
+
+    /**
+     * Position of the element [col][row] in memory.
+     */
+    inline long offset(int col, int row) const {
+        return columnOffset(col) + (long) ((unsigned) row / TileRows) * tileSize + (unsigned) row % TileRows;
+    }
+
+    inline S &at(long offset) {
+        return rawData[offset];
+    }
+
+    inline const S &at(long offset) const {
+        return rawData[offset];
+    }
+
+    inline Column<S> operator[](int index) {
+        return Column<S>(rawData + columnOffset(index));
+    }
+
+    inline Column<const S> operator[](int index) const {
+        return Column<const S>(rawData + columnOffset(index));
+    }
+
+protected:
+    Float2DTiledT(int cols, int rows, std::shared_ptr<S> sharedData) :
+            cols(cols),
+            rows(rows),
+            tilesX((cols + TileCols - 1) / TileCols),
+            tilesY((rows + TileRows - 1) / TileRows),
+            data(sharedData),
+            rawData(sharedData.get()) {}
+
+    inline long columnOffset(int col) const {
+        return (long) ((unsigned) col / TileCols) * tilesY * tileSize + (long) ((unsigned) col % TileCols) * TileRows;
+    }
+
+    int cols;
+    int rows;
+    int tilesX;
+    int tilesY;
+
+    std::shared_ptr<S> data;
+    S *rawData;
+};
+
+/*
+ * Buffer for local timestepping with the tiled layout, see Float2DBuffer.
+ */
+template<typename S, int TileCols = 4, int TileRows = 16>
+class Float2DTiledBufferT : public Float2DTiledT<S, TileCols, TileRows> {
+public:
+    Float2DTiledBufferT() {}
+
+    Float2DTiledBufferT(int cols, int rows, bool localTimestepping, Float2DTiledT<S, TileCols, TileRows> &realData,
+                        tools::BlockArena &arena) :
+            Float2DTiledT<S, TileCols, TileRows>(cols, rows, realData.getPointer()) {
+
+        if (localTimestepping) {
+            this->data = arena.allocate<S>(this->getSize());
+            this->rawData = this->data.get();
+        }
+        // Otherwise the buffer points to h | hu | hv
+    }
+
+    ~Float2DTiledBufferT() {}
+};
+
+typedef Float2DTiledT<float> Float2DTiled;
+typedef Float2DTiledBufferT<float> Float2DTiledBuffer;
+
+/**
+ * Column-major copy for the writers, see toFloat2D in tools/Float2DNative.hh.
+ */
+template<typename S, int TileCols, int TileRows>
+Float2DNative toFloat2D(const Float2DTiledT<S, TileCols, TileRows> &array) {
+    return tools::copyToFloat2D(array);
+}
+
+#endif // __FLOAT2DTILED_HH
@@ -4,6 +4,7 @@
 #include <upcxx/upcxx.hpp>
 
 #include "tools/Float2D.hh"
+#include "tools/BlockArena.hh"
 
 class Float2DUpcxx : public Float2D {
 public:
@@ -13,6 +14,10 @@ public:
         rawData = data.local();
     }
 
+    // The arrays have to be in the shared segment, they are not allocated from the arena
+    Float2DUpcxx(int cols, int rows, tools::BlockArena &arena) :
+            Float2DUpcxx(cols, rows) {}
+
     ~Float2DUpcxx() {}
 
     upcxx::global_ptr<float> getPointer() const {
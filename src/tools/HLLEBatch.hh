@@ -0,0 +1,218 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Batched HLLE f-wave solver operating on whole columns of edges.
+ *
+ * The edge n of a batch is formed by the cells left[n] and right[n], so a column of
+ * vertical edges is passed as (column i - 1, column i) and a column of horizontal edges
+ * as (column i starting at row j - 1, column i starting at row j).
+ * Since Float2D is stored column-major, all inputs and outputs are contiguous.
+ *
+ * The numerics follow solver::HLLEFun (Einfeldt speeds, f-wave decomposition with the
+ * bathymetry source term, reflecting wet/dry edges), but the dry/wet branches are
+ * evaluated with masks so that simd::Vector::width edges are solved at once.
+ * The bathymetry is either passed as two columns or as precomputed differences per edge.
+ * The remainder of a batch is handled by the scalar instantiation of the same kernel.
+ */
+
+#ifndef __HLLEBATCH_HH
+#define __HLLEBATCH_HH
+
+#include "tools/SimdFloat.hh"
+
+#if defined(WAVE_PROPAGATION_SOLVER) && WAVE_PROPAGATION_SOLVER != 0
+#error "The batched solver is only available for the HLLE solver (WAVE_PROPAGATION_SOLVER=0)"
+#endif
+
+namespace solver {
+
+class HLLEBatch {
+public:
+    HLLEBatch(float dryTol = 0.01, float gravity = 9.81, float zeroTol = 0.0000001) :
+            dryTol(dryTol),
+            g(gravity),
+            zeroTol(zeroTol) {}
+
+    /**
+     * Compute the net updates for n consecutive edges.
+     *
+     * @return the maximum wave speed of all n edges
+     */
+    float computeNetUpdates(int n,
+                            const float *hLeft, const float *hRight,
+                            const float *huLeft, const float *huRight,
+                            const float *bLeft, const float *bRight,
+                            float *hUpdateLeft, float *hUpdateRight,
+                            float *huUpdateLeft, float *huUpdateRight) const {
+        return computeBatch(n, hLeft, hRight, huLeft, huRight, bLeft, bRight, nullptr,
+                            hUpdateLeft, hUpdateRight, huUpdateLeft, huUpdateRight);
+    }
+
+    /**
+     * Compute the net updates for n consecutive edges with precomputed bathymetry differences
+     * bRight - bLeft (see EdgeBathymetry), the results are identical to the variant above.
+     *
+     * @return the maximum wave speed of all n edges
+     */
+    float computeNetUpdates(int n,
+                            const float *hLeft, const float *hRight,
+                            const float *huLeft, const float *huRight,
+                            const float *bDelta,
+                            float *hUpdateLeft, float *hUpdateRight,
+                            float *huUpdateLeft, float *huUpdateRight) const {
+        return computeBatch(n, hLeft, hRight, huLeft, huRight, nullptr, nullptr, bDelta,
+                            hUpdateLeft, hUpdateRight, huUpdateLeft, huUpdateRight);
+    }
+
+private:
+    float computeBatch(int n,
+                       const float *hLeft, const float *hRight,
+                       const float *huLeft, const float *huRight,
+                       const float *bLeft, const float *bRight, const float *bDelta,
+                       float *hUpdateLeft, float *hUpdateRight,
+                       float *huUpdateLeft, float *huUpdateRight) const {
+        const int vectorEnd = n - n % simd::Vector::width;
+
+        simd::Vector maxWaveSpeed = simd::Vector::set1(0.f);
+        for (int k = 0; k < vectorEnd; k += simd::Vector::width) {
+            maxWaveSpeed = simd::max(maxWaveSpeed, solve<simd::Vector>(k, hLeft, hRight, huLeft, huRight, bLeft, bRight, bDelta,
+                                                                      hUpdateLeft, hUpdateRight, huUpdateLeft, huUpdateRight));
+        }
+
+        float result = maxWaveSpeed.reduceMax();
+        for (int k = vectorEnd; k < n; k++) {
+            result = std::max(result, solve<simd::Scalar>(k, hLeft, hRight, huLeft, huRight, bLeft, bRight, bDelta,
+                                                         hUpdateLeft, hUpdateRight, huUpdateLeft, huUpdateRight).v);
+        }
+
+        return result;
+    }
+
+    template<typename V>
+    V solve(int k,
+            const float *hLeft, const float *hRight,
+            const float *huLeft, const float *huRight,
+            const float *bLeft, const float *bRight, const float *bDelta,
+            float *hUpdateLeft, float *hUpdateRight,
+            float *huUpdateLeft, float *huUpdateRight) const {
+        typedef typename V::Mask Mask;
+
+        const V zero = V::set1(0.f);
+        const V half = V::set1(0.5f);
+        const V gravity = V::set1(g);
+
+        V hL = V::load(hLeft + k);
+        V hR = V::load(hRight + k);
+        V huL = V::load(huLeft + k);
+        V huR = V::load(huRight + k);
+        V deltaB = bDelta ? V::load(bDelta + k) : V::load(bRight + k) - V::load(bLeft + k);
+
+        /*
+         * Wet/dry handling:
+         * a dry cell next to a wet cell acts as a reflecting wall,
+         * edges between two dry cells do not produce any updates.
+         */
+        const V tol = V::set1(dryTol);
+        const Mask wetLeft = hL >= tol;
+        const Mask wetRight = hR >= tol;
+        const Mask dryLeft = !wetLeft;
+        const Mask dryRight = !wetRight;
+        const Mask wetDry = wetLeft & dryRight;
+        const Mask dryWet = dryLeft & wetRight;
+        const Mask dryDry = dryLeft & dryRight;
+
+        hR = simd::select(wetDry, hL, hR);
+        huR = simd::select(wetDry, -huL, huR);
+
+        hL = simd::select(dryWet, hR, hL);
+        huL = simd::select(dryWet, -huR, huL);
+
+        // Dummy state for dry edges, keeps the arithmetic below finite
+        hL = simd::select(dryDry, tol, hL);
+        hR = simd::select(dryDry, tol, hR);
+        huL = simd::select(dryDry, zero, huL);
+        huR = simd::select(dryDry, zero, huR);
+
+        // Walls and dry edges see a flat bottom
+        deltaB = simd::select(wetDry | dryWet | dryDry, zero, deltaB);
+
+        const V uL = huL / hL;
+        const V uR = huR / hR;
+        const V sqrtHL = simd::sqrt(hL);
+        const V sqrtHR = simd::sqrt(hR);
+
+        // Roe averages and Einfeldt speeds
+        const V hRoe = half * (hL + hR);
+        const V uRoe = (uL * sqrtHL + uR * sqrtHR) / (sqrtHL + sqrtHR);
+        const V cRoe = simd::sqrt(gravity * hRoe);
+
+        const V s1 = simd::min(uL - simd::sqrt(gravity * hL), uRoe - cRoe);
+        const V s2 = simd::max(uR + simd::sqrt(gravity * hR), uRoe + cRoe);
+
+        // Flux jump including the bathymetry source term
+        const V fDeltaH = huR - huL;
+        const V fDeltaHu = huR * uR + half * gravity * hR * hR
+                           - (huL * uL + half * gravity * hL * hL)
+                           + gravity * hRoe * deltaB;
+
+        // f-wave decomposition into the eigenvectors (1, s1) and (1, s2)
+        const V inverseDet = V::set1(1.f) / (s2 - s1);
+        const V beta1 = (s2 * fDeltaH - fDeltaHu) * inverseDet;
+        const V beta2 = (fDeltaHu - s1 * fDeltaH) * inverseDet;
+
+        // Share of each wave going to the left cell: 1, 0, or 1/2 for (almost) stationary waves
+        const V one = V::set1(1.f);
+        const V negTol = V::set1(-zeroTol);
+        const V posTol = V::set1(zeroTol);
+        const V left1 = simd::select(s1 < negTol, one, simd::select(s1 > posTol, zero, half));
+        const V left2 = simd::select(s2 < negTol, one, simd::select(s2 > posTol, zero, half));
+
+        V hUL = left1 * beta1 + left2 * beta2;
+        V hUR = (one - left1) * beta1 + (one - left2) * beta2;
+        V huUL = left1 * beta1 * s1 + left2 * beta2 * s2;
+        V huUR = (one - left1) * beta1 * s1 + (one - left2) * beta2 * s2;
+
+        // The reflecting wall does not update the dry cell
+        const Mask noLeft = dryWet | dryDry;
+        const Mask noRight = wetDry | dryDry;
+        hUL = simd::select(noLeft, zero, hUL);
+        huUL = simd::select(noLeft, zero, huUL);
+        hUR = simd::select(noRight, zero, hUR);
+        huUR = simd::select(noRight, zero, huUR);
+
+        hUL.store(hUpdateLeft + k);
+        hUR.store(hUpdateRight + k);
+        huUL.store(huUpdateLeft + k);
+        huUR.store(huUpdateRight + k);
+
+        return simd::select(dryDry, zero, simd::max(simd::abs(s1), simd::abs(s2)));
+    }
+
+    // Cells with a water height below dryTol are considered dry
+    float dryTol;
+    float g;
+    // Wave speeds within zeroTol are treated as stationary
+    float zeroTol;
+};
+
+} // namespace solver
+
+#endif // __HLLEBATCH_HH
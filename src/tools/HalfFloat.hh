@@ -0,0 +1,179 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * 16 bit storage types for the unknowns.
+ *
+ * tools::Half is IEEE 754 binary16 (5 exponent bits, 10 mantissa bits),
+ * tools::BFloat16 keeps the exponent range of float with 7 mantissa bits.
+ * Both are storage types only: every read converts to float and every write rounds
+ * the float value to the nearest representable value (ties to even), so Float2DT<Half>
+ * can be used in place of Float2D by the block kernels.
+ */
+
+#ifndef __HALFFLOAT_HH
+#define __HALFFLOAT_HH
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+namespace tools {
+
+inline uint32_t floatToBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+class Half {
+public:
+    Half() {}
+
+    Half(float value) :
+            bits(fromFloat(value)) {}
+
+    operator float() const {
+        return toFloat(bits);
+    }
+
+    Half &operator+=(float value) {
+        return *this = *this + value;
+    }
+
+    Half &operator-=(float value) {
+        return *this = *this - value;
+    }
+
+    Half &operator*=(float value) {
+        return *this = *this * value;
+    }
+
+    Half &operator/=(float value) {
+        return *this = *this / value;
+    }
+
+private:
+    static uint16_t fromFloat(float value) {
+#if defined(__F16C__)
+        return _cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT);
+#else
+        const uint32_t x = floatToBits(value);
+        const uint16_t sign = (x >> 16) & 0x8000;
+        const uint32_t absX = x & 0x7fffffff;
+
+        // Inf and NaN
+        if (absX >= 0x7f800000)
+            return sign | 0x7c00 | (absX > 0x7f800000 ? 0x200 : 0);
+        // Rounds to a value beyond 65504
+        if (absX >= 0x477ff000)
+            return sign | 0x7c00;
+        // Normal numbers: rebias the exponent and round the mantissa to nearest even
+        if (absX >= 0x38800000)
+            return sign | ((absX - 0x38000000 + 0xfff + ((absX >> 13) & 1)) >> 13);
+        // Rounds to zero
+        if (absX <= 0x33000000)
+            return sign;
+
+        // Subnormal numbers
+        const uint32_t mantissa = (absX & 0x7fffff) | 0x800000;
+        const int shift = 126 - (absX >> 23);
+        const uint32_t halfway = 1u << (shift - 1);
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t result = mantissa >> shift;
+        if (remainder > halfway || (remainder == halfway && (result & 1)))
+            result++;
+        return sign | result;
+#endif
+    }
+
+    static float toFloat(uint16_t h) {
+#if defined(__F16C__)
+        return _cvtsh_ss(h);
+#else
+        const uint32_t sign = (uint32_t) (h & 0x8000) << 16;
+        const uint32_t exponent = (h >> 10) & 0x1f;
+        const uint32_t mantissa = h & 0x3ff;
+
+        if (exponent == 0) {
+            // Zero and subnormal numbers, mantissa * 2^-24
+            const float magnitude = (float) mantissa * 5.9604644775390625e-8f;
+            return sign ? -magnitude : magnitude;
+        }
+        if (exponent == 0x1f)
+            return bitsToFloat(sign | 0x7f800000 | (mantissa << 13));
+        return bitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+#endif
+    }
+
+    uint16_t bits;
+};
+
+class BFloat16 {
+public:
+    BFloat16() {}
+
+    BFloat16(float value) :
+            bits(fromFloat(value)) {}
+
+    operator float() const {
+        return bitsToFloat((uint32_t) bits << 16);
+    }
+
+    BFloat16 &operator+=(float value) {
+        return *this = *this + value;
+    }
+
+    BFloat16 &operator-=(float value) {
+        return *this = *this - value;
+    }
+
+    BFloat16 &operator*=(float value) {
+        return *this = *this * value;
+    }
+
+    BFloat16 &operator/=(float value) {
+        return *this = *this / value;
+    }
+
+private:
+    static uint16_t fromFloat(float value) {
+        const uint32_t x = floatToBits(value);
+        // Keep NaNs quiet, truncation could turn them into Inf
+        if ((x & 0x7fffffff) > 0x7f800000)
+            return (x >> 16) | 0x40;
+        return (x + 0x7fff + ((x >> 16) & 1)) >> 16;
+    }
+
+    uint16_t bits;
+};
+
+} // namespace tools
+
+#endif // __HALFFLOAT_HH
@@ -0,0 +1,136 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Ghost layer mailbox in memory shared between two processes of a node (see MPI_Win_allocate_shared).
+ *
+ * The receiving block owns the mailbox of each of its borders, the neighbouring block writes its boundary cells
+ * into it and the receiver copies them into its ghost layer. Exchanges are numbered 1, 2, ... per border.
+ * The mailbox has two slots, used alternately, so the sender only waits if the receiver has not consumed
+ * the exchange before the previous one yet:
+ *  - ready: last exchange written by the sender, published with release semantics after the cells
+ *  - consumed: last exchange copied out by the receiver
+ *
+ * A slot holds h, hu and hv of count cells and the timestep of the sender.
+ */
+
+#ifndef __SHAREDMAILBOX_HH
+#define __SHAREDMAILBOX_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+#include "tools/SimulationTime.hh"
+
+template<typename S>
+class SharedMailbox {
+public:
+    static const int slots = 2;
+
+    SharedMailbox() :
+            header(nullptr), cells(nullptr), count(0) {}
+
+    SharedMailbox(void *memory, int count) :
+            header(static_cast<Header *>(alignHeader(memory))),
+            cells(reinterpret_cast<S *>(reinterpret_cast<char *>(header) + sizeof(Header))),
+            count(count) {}
+
+    /**
+     * Bytes of shared memory of a mailbox for count cells.
+     * MPI aligns the memory of a shared window to 8 bytes only (Open MPI), so it includes room
+     * to align the counters to their cache lines. The shared memory is mapped at page boundaries,
+     * so the sender finds the header at the same offset as the receiver.
+     */
+    static size_t size(int count) {
+        return alignof(Header) - 1 + sizeof(Header) + (size_t) slots * 3 * count * sizeof(S);
+    }
+
+    /**
+     * Constructs the counters, has to be called by the owner before the neighbour accesses the mailbox.
+     */
+    void initialize() {
+        new(header) Header();
+    }
+
+    /**
+     * Waits until the slot of exchange is free and returns its h, hu and hv cells (count cells each).
+     */
+    S *beginWrite(long exchange) {
+        wait(header->consumed, exchange - slots);
+        return slot(exchange);
+    }
+
+    void endWrite(long exchange, TimeScalar timestep) {
+        header->timestep[exchange % slots] = timestep;
+        header->ready.store(exchange, std::memory_order_release);
+    }
+
+    bool isReady(long exchange) const {
+        return header->ready.load(std::memory_order_acquire) >= exchange;
+    }
+
+    /**
+     * Waits until the sender has written exchange and returns its h, hu and hv cells.
+     */
+    const S *beginRead(long exchange, TimeScalar &timestep) {
+        wait(header->ready, exchange);
+        timestep = header->timestep[exchange % slots];
+        return slot(exchange);
+    }
+
+    void endRead(long exchange) {
+        header->consumed.store(exchange, std::memory_order_release);
+    }
+
+private:
+    struct Header {
+        // The counters are written by different processes, so they are kept in separate cache lines
+        alignas(64) std::atomic<long> ready{0};
+        alignas(64) std::atomic<long> consumed{0};
+        TimeScalar timestep[slots];
+    };
+
+    static_assert(sizeof(Header) % alignof(Header) == 0, "The cells start behind the padded header");
+
+    static_assert(ATOMIC_LONG_LOCK_FREE == 2, "The mailbox counters are shared between processes");
+
+    static void *alignHeader(void *memory) {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+        return reinterpret_cast<void *>((address + alignof(Header) - 1) / alignof(Header) * alignof(Header));
+    }
+
+    static void wait(const std::atomic<long> &counter, long value) {
+        while (counter.load(std::memory_order_acquire) < value)
+            std::this_thread::yield();
+    }
+
+    S *slot(long exchange) const {
+        return cells + (exchange % slots) * 3 * count;
+    }
+
+    Header *header;
+    S *cells;
+    int count;
+};
+
+#endif // __SHAREDMAILBOX_HH
@@ -0,0 +1,231 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Minimal portable SIMD wrapper for single precision kernels.
+ *
+ * simd::Scalar processes one value and is always available,
+ * simd::Vector maps to the widest instruction set enabled at compile time
+ * (AVX-512F, AVX/AVX2, otherwise it falls back to simd::Scalar).
+ * Both types provide the same interface, so kernels can be written once as a template
+ * and instantiated for the vector body and the scalar remainder of a loop.
+ * Comparisons return a mask type, which is consumed by select() to handle branches without branching.
+ */
+
+#ifndef __SIMDFLOAT_HH
+#define __SIMDFLOAT_HH
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+/***********
+ * SCALAR *
+ **********/
+
+struct ScalarMask {
+    bool m;
+};
+
+inline ScalarMask operator&(ScalarMask a, ScalarMask b) { return {a.m && b.m}; }
+
+inline ScalarMask operator|(ScalarMask a, ScalarMask b) { return {a.m || b.m}; }
+
+inline ScalarMask operator!(ScalarMask a) { return {!a.m}; }
+
+struct Scalar {
+    typedef ScalarMask Mask;
+    static const int width = 1;
+
+    float v;
+
+    static Scalar load(const float *p) { return {*p}; }
+
+    static Scalar set1(float x) { return {x}; }
+
+    void store(float *p) const { *p = v; }
+
+    float reduceMax() const { return v; }
+};
+
+inline Scalar operator+(Scalar a, Scalar b) { return {a.v + b.v}; }
+
+inline Scalar operator-(Scalar a, Scalar b) { return {a.v - b.v}; }
+
+inline Scalar operator*(Scalar a, Scalar b) { return {a.v * b.v}; }
+
+inline Scalar operator/(Scalar a, Scalar b) { return {a.v / b.v}; }
+
+inline Scalar operator-(Scalar a) { return {-a.v}; }
+
+inline ScalarMask operator<(Scalar a, Scalar b) { return {a.v < b.v}; }
+
+inline ScalarMask operator>(Scalar a, Scalar b) { return {a.v > b.v}; }
+
+inline ScalarMask operator>=(Scalar a, Scalar b) { return {a.v >= b.v}; }
+
+inline Scalar sqrt(Scalar a) { return {std::sqrt(a.v)}; }
+
+inline Scalar abs(Scalar a) { return {std::fabs(a.v)}; }
+
+inline Scalar min(Scalar a, Scalar b) { return {std::min(a.v, b.v)}; }
+
+inline Scalar max(Scalar a, Scalar b) { return {std::max(a.v, b.v)}; }
+
+// Returns a where the mask is set, b otherwise
+inline Scalar select(ScalarMask m, Scalar a, Scalar b) { return m.m ? a : b; }
+
+#if defined(__AVX512F__)
+
+/************
+ * AVX-512 *
+ ***********/
+
+struct Avx512Mask {
+    __mmask16 m;
+};
+
+inline Avx512Mask operator&(Avx512Mask a, Avx512Mask b) { return {(__mmask16) (a.m & b.m)}; }
+
+inline Avx512Mask operator|(Avx512Mask a, Avx512Mask b) { return {(__mmask16) (a.m | b.m)}; }
+
+inline Avx512Mask operator!(Avx512Mask a) { return {(__mmask16) ~a.m}; }
+
+struct Avx512 {
+    typedef Avx512Mask Mask;
+    static const int width = 16;
+
+    __m512 v;
+
+    static Avx512 load(const float *p) { return {_mm512_loadu_ps(p)}; }
+
+    static Avx512 set1(float x) { return {_mm512_set1_ps(x)}; }
+
+    void store(float *p) const { _mm512_storeu_ps(p, v); }
+
+    float reduceMax() const { return _mm512_reduce_max_ps(v); }
+};
+
+inline Avx512 operator+(Avx512 a, Avx512 b) { return {_mm512_add_ps(a.v, b.v)}; }
+
+inline Avx512 operator-(Avx512 a, Avx512 b) { return {_mm512_sub_ps(a.v, b.v)}; }
+
+inline Avx512 operator*(Avx512 a, Avx512 b) { return {_mm512_mul_ps(a.v, b.v)}; }
+
+inline Avx512 operator/(Avx512 a, Avx512 b) { return {_mm512_div_ps(a.v, b.v)}; }
+
+inline Avx512 operator-(Avx512 a) { return {_mm512_sub_ps(_mm512_setzero_ps(), a.v)}; }
+
+inline Avx512Mask operator<(Avx512 a, Avx512 b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+
+inline Avx512Mask operator>(Avx512 a, Avx512 b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)}; }
+
+inline Avx512Mask operator>=(Avx512 a, Avx512 b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)}; }
+
+inline Avx512 sqrt(Avx512 a) { return {_mm512_sqrt_ps(a.v)}; }
+
+inline Avx512 abs(Avx512 a) { return {_mm512_abs_ps(a.v)}; }
+
+inline Avx512 min(Avx512 a, Avx512 b) { return {_mm512_min_ps(a.v, b.v)}; }
+
+inline Avx512 max(Avx512 a, Avx512 b) { return {_mm512_max_ps(a.v, b.v)}; }
+
+inline Avx512 select(Avx512Mask m, Avx512 a, Avx512 b) { return {_mm512_mask_blend_ps(m.m, b.v, a.v)}; }
+
+typedef Avx512 Vector;
+
+#elif defined(__AVX__)
+
+/*************
+ * AVX/AVX2 *
+ ************/
+
+struct AvxMask {
+    __m256 m;
+};
+
+inline AvxMask operator&(AvxMask a, AvxMask b) { return {_mm256_and_ps(a.m, b.m)}; }
+
+inline AvxMask operator|(AvxMask a, AvxMask b) { return {_mm256_or_ps(a.m, b.m)}; }
+
+inline AvxMask operator!(AvxMask a) { return {_mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+
+struct Avx {
+    typedef AvxMask Mask;
+    static const int width = 8;
+
+    __m256 v;
+
+    static Avx load(const float *p) { return {_mm256_loadu_ps(p)}; }
+
+    static Avx set1(float x) { return {_mm256_set1_ps(x)}; }
+
+    void store(float *p) const { _mm256_storeu_ps(p, v); }
+
+    float reduceMax() const {
+        __m128 r = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+        r = _mm_max_ss(r, _mm_shuffle_ps(r, r, 1));
+        return _mm_cvtss_f32(r);
+    }
+};
+
+inline Avx operator+(Avx a, Avx b) { return {_mm256_add_ps(a.v, b.v)}; }
+
+inline Avx operator-(Avx a, Avx b) { return {_mm256_sub_ps(a.v, b.v)}; }
+
+inline Avx operator*(Avx a, Avx b) { return {_mm256_mul_ps(a.v, b.v)}; }
+
+inline Avx operator/(Avx a, Avx b) { return {_mm256_div_ps(a.v, b.v)}; }
+
+inline Avx operator-(Avx a) { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.f))}; }
+
+inline AvxMask operator<(Avx a, Avx b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+
+inline AvxMask operator>(Avx a, Avx b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+
+inline AvxMask operator>=(Avx a, Avx b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+
+inline Avx sqrt(Avx a) { return {_mm256_sqrt_ps(a.v)}; }
+
+inline Avx abs(Avx a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v)}; }
+
+inline Avx min(Avx a, Avx b) { return {_mm256_min_ps(a.v, b.v)}; }
+
+inline Avx max(Avx a, Avx b) { return {_mm256_max_ps(a.v, b.v)}; }
+
+inline Avx select(AvxMask m, Avx a, Avx b) { return {_mm256_blendv_ps(b.v, a.v, m.m)}; }
+
+typedef Avx Vector;
+
+#else
+
+typedef Scalar Vector;
+
+#endif
+
+} // namespace simd
+
+#endif // __SIMDFLOAT_HH
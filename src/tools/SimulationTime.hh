@@ -0,0 +1,54 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Type of the simulation time, selected at compile time:
+ * double with DOUBLE_PRECISION_TIME, float otherwise.
+ *
+ * The simulation time, the local timestepping time of a block and the timestamps exchanged
+ * with neighbouring blocks use TimeScalar. The width of a single timestep stays in single precision.
+ */
+
+#ifndef __SIMULATIONTIME_HH
+#define __SIMULATIONTIME_HH
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(DOUBLE_PRECISION_TIME)
+typedef double TimeScalar;
+#define MPI_TIME_TYPE MPI_DOUBLE
+#else
+typedef float TimeScalar;
+#define MPI_TIME_TYPE MPI_FLOAT
+#endif
+
+/**
+ * Compares two points in time up to the rounding error of TimeScalar.
+ * The error of a time accumulated over many timesteps grows with its magnitude,
+ * so the tolerance is relative.
+ */
+inline bool timesEqual(TimeScalar a, TimeScalar b) {
+    const TimeScalar magnitude = std::max(std::max(std::abs(a), std::abs(b)), (TimeScalar) 1);
+    return std::abs(a - b) <= 4 * std::numeric_limits<TimeScalar>::epsilon() * magnitude;
+}
+
+#endif // __SIMULATIONTIME_HH
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Storage type of the unknowns h, hu, hv and b, selected at compile time:
+ * STATE_STORAGE_HALF (IEEE binary16), STATE_STORAGE_BFLOAT16, STATE_STORAGE_DOUBLE, float otherwise.
+ *
+ * Blocks supporting these storage types use Float2DState/Float2DStateBuffer as array types.
+ * Net updates and all intermediate values stay in single precision,
+ * double storage only avoids the rounding of the accumulated cell updates.
+ *
+ * With INTERLEAVED_STATE, h, hu, hv and b of a cell are stored next to each other (see tools/Float2DInterleaved.hh).
+ */
+
+#ifndef __STATESTORAGE_HH
+#define __STATESTORAGE_HH
+
+#include "tools/Float2D.hh"
+#include "tools/Float2DNative.hh"
+#include "tools/Float2DBuffer.hh"
+#include "tools/Float2DInterleaved.hh"
+
+#if (defined(STATE_STORAGE_HALF) + defined(STATE_STORAGE_BFLOAT16) + defined(STATE_STORAGE_DOUBLE)) > 1
+#error "Only one of STATE_STORAGE_HALF, STATE_STORAGE_BFLOAT16 and STATE_STORAGE_DOUBLE can be selected"
+#endif
+
+#if defined(STATE_STORAGE_HALF) || defined(STATE_STORAGE_BFLOAT16)
+#define STATE_STORAGE_COMPACT
+#include "tools/HalfFloat.hh"
+#endif
+
+#if defined(STATE_STORAGE_HALF)
+typedef tools::Half StateScalar;
+#elif defined(STATE_STORAGE_BFLOAT16)
+typedef tools::BFloat16 StateScalar;
+#elif defined(STATE_STORAGE_DOUBLE)
+typedef double StateScalar;
+#else
+typedef float StateScalar;
+#endif
+
+#if defined(INTERLEAVED_STATE)
+typedef Float2DInterleavedT<StateScalar> Float2DState;
+typedef Float2DInterleavedBufferT<StateScalar> Float2DStateBuffer;
+#else
+typedef Float2DNativeT<StateScalar> Float2DState;
+typedef Float2DBufferT<StateScalar> Float2DStateBuffer;
+#endif
+
+#endif // __STATESTORAGE_HH
@@ -0,0 +1,167 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Activity bitmap of a block at tile granularity.
+ *
+ * A cell is quiet if it is dry and at rest (h == hu == hv == 0). Every edge between two quiet cells
+ * is a dry/dry edge, which produces neither net updates nor a wave speed,
+ * so a tile whose cells and direct neighbours are all quiet does not change during a timestep and can be skipped.
+ *
+ * The bitmap keeps two flags per tile:
+ * "wet" if the tile contains a non-quiet cell, updated after each cell update for the tiles that were computed
+ * (all other tiles did not change), and "active" if the tile or one of its neighbouring tiles is wet,
+ * or if one of the ghost cells next to the tile is not quiet.
+ */
+
+#ifndef __TILEACTIVITY_HH
+#define __TILEACTIVITY_HH
+
+#include <algorithm>
+#include <vector>
+
+#include "tools/Float2D.hh"
+
+class TileActivity {
+public:
+    TileActivity() :
+            nx(0), ny(0), tileSize(1), tilesX(0), tilesY(0) {}
+
+    TileActivity(int nx, int ny, int tileSize) :
+            nx(nx), ny(ny), tileSize(tileSize),
+            tilesX((nx + tileSize - 1) / tileSize),
+            tilesY((ny + tileSize - 1) / tileSize),
+            // Everything is considered wet until the first update
+            wet(tilesX * tilesY, 1),
+            active(tilesX * tilesY, 1) {}
+
+    int getTilesX() const {
+        return tilesX;
+    }
+
+    int getTilesY() const {
+        return tilesY;
+    }
+
+    // First cell column of the tile, the cells of the block start at index 1
+    int xBegin(int tileX) const {
+        return 1 + tileX * tileSize;
+    }
+
+    // One past the last cell column of the tile
+    int xEnd(int tileX) const {
+        return std::min(xBegin(tileX) + tileSize, nx + 1);
+    }
+
+    int yBegin(int tileY) const {
+        return 1 + tileY * tileSize;
+    }
+
+    int yEnd(int tileY) const {
+        return std::min(yBegin(tileY) + tileSize, ny + 1);
+    }
+
+    bool isActive(int tileX, int tileY) const {
+        return active[tileX * tilesY + tileY];
+    }
+
+    /**
+     * Recomputes the wet flag of all active tiles, has to be called after the cells have been updated.
+     */
+    template<typename Array>
+    void updateWet(const Array &h, const Array &hu, const Array &hv) {
+        for (int tileX = 0; tileX < tilesX; tileX++) {
+            for (int tileY = 0; tileY < tilesY; tileY++) {
+                if (!isActive(tileX, tileY))
+                    continue;
+
+                bool tileWet = false;
+                for (int i = xBegin(tileX); i < xEnd(tileX) && !tileWet; i++) {
+                    for (int j = yBegin(tileY); j < yEnd(tileY); j++) {
+                        if (!isQuiet(h, hu, hv, i, j)) {
+                            tileWet = true;
+                            break;
+                        }
+                    }
+                }
+                wet[tileX * tilesY + tileY] = tileWet;
+            }
+        }
+    }
+
+    /**
+     * Determines the active tiles from the wet flags and the ghost layer,
+     * has to be called after the ghost layer has been set.
+     *
+     * @return the number of active tiles
+     */
+    template<typename Array>
+    int updateActive(const Array &h, const Array &hu, const Array &hv) {
+        std::fill(active.begin(), active.end(), 0);
+
+        // Wet tiles activate themselves and their neighbours
+        for (int tileX = 0; tileX < tilesX; tileX++) {
+            for (int tileY = 0; tileY < tilesY; tileY++) {
+                if (!wet[tileX * tilesY + tileY])
+                    continue;
+                for (int x = std::max(tileX - 1, 0); x < std::min(tileX + 2, tilesX); x++) {
+                    for (int y = std::max(tileY - 1, 0); y < std::min(tileY + 2, tilesY); y++) {
+                        active[x * tilesY + y] = 1;
+                    }
+                }
+            }
+        }
+
+        // Ghost cells activate the tiles along the block boundary, including the corners
+        for (int i = 0; i < nx + 2; i++) {
+            const int tileX = std::min(std::max(i - 1, 0), nx - 1) / tileSize;
+            if (!isQuiet(h, hu, hv, i, 0))
+                active[tileX * tilesY] = 1;
+            if (!isQuiet(h, hu, hv, i, ny + 1))
+                active[tileX * tilesY + tilesY - 1] = 1;
+        }
+        for (int j = 0; j < ny + 2; j++) {
+            const int tileY = std::min(std::max(j - 1, 0), ny - 1) / tileSize;
+            if (!isQuiet(h, hu, hv, 0, j))
+                active[tileY] = 1;
+            if (!isQuiet(h, hu, hv, nx + 1, j))
+                active[(tilesX - 1) * tilesY + tileY] = 1;
+        }
+
+        return (int) std::count(active.begin(), active.end(), 1);
+    }
+
+private:
+    template<typename Array>
+    static bool isQuiet(const Array &h, const Array &hu, const Array &hv, int i, int j) {
+        return h[i][j] == 0 && hu[i][j] == 0 && hv[i][j] == 0;
+    }
+
+    int nx;
+    int ny;
+    int tileSize;
+    int tilesX;
+    int tilesY;
+
+    std::vector<char> wet;
+    std::vector<char> active;
+};
+
+#endif // __TILEACTIVITY_HH
@@ -0,0 +1,219 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ * Bounding box of the cells of a block that have been reached by a wave.
+ *
+ * A cell whose edges produced zero net updates did not change. If neither the cell nor its neighbours changed,
+ * its edges see the same states in the next timestep and produce zero net updates again.
+ * So only the cells inside the bounding box of the changed cells, grown by one cell, have to be computed.
+ * The first timestep is computed on the whole block, afterwards the box only grows:
+ * every cell outside of it is still in its initial state.
+ *
+ * Changes of the ghost layer (neighbouring blocks, boundary conditions) add the adjacent cells to the box.
+ * Since the edges outside of the box are not solved anymore, their wave speeds are bounded by
+ * |u| + sqrt(g * h) of the initial state of the cells outside of the box after the first timestep.
+ */
+
+#ifndef __WAVEFRONTBOX_HH
+#define __WAVEFRONTBOX_HH
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "tools/Float2D.hh"
+
+class WavefrontBox {
+public:
+    WavefrontBox() :
+            nx(0), ny(0), iBegin(1), iEnd(1), jBegin(1), jEnd(1),
+            firstTimestep(true), outsideWaveSpeed(0) {
+        resetChanged();
+    }
+
+    WavefrontBox(int nx, int ny) :
+            nx(nx), ny(ny),
+            // The first timestep is computed on the whole block
+            iBegin(1), iEnd(nx + 1), jBegin(1), jEnd(ny + 1),
+            firstTimestep(true), outsideWaveSpeed(0),
+            ghostLayer(3 * 2 * (nx + ny)) {
+        resetChanged();
+    }
+
+    // Cell range [iBegin, iEnd) x [jBegin, jEnd) that has to be computed
+    int getIBegin() const {
+        return iBegin;
+    }
+
+    int getIEnd() const {
+        return iEnd;
+    }
+
+    int getJBegin() const {
+        return jBegin;
+    }
+
+    int getJEnd() const {
+        return jEnd;
+    }
+
+    /**
+     * Upper bound of the wave speeds of all edges outside of the box.
+     */
+    float getOutsideWaveSpeed() const {
+        return outsideWaveSpeed;
+    }
+
+    /**
+     * Adds the cells next to changed ghost cells to the box,
+     * has to be called after the ghost layer has been set.
+     */
+    template<typename Array>
+    void checkGhostLayer(const Array &h, const Array &hu, const Array &hv) {
+        const Array *arrays[3] = {&h, &hu, &hv};
+
+        int k = 0;
+        for (int a = 0; a < 3; a++) {
+            const Array &q = *arrays[a];
+            for (int i = 1; i < nx + 1; i++) {
+                checkGhostCell(q[i][0], k++, i, 1);
+                checkGhostCell(q[i][ny + 1], k++, i, ny);
+            }
+            for (int j = 1; j < ny + 1; j++) {
+                checkGhostCell(q[0][j], k++, 1, j);
+                checkGhostCell(q[nx + 1][j], k++, nx, j);
+            }
+        }
+
+        if (!firstTimestep)
+            include(changedIBegin, changedIEnd, changedJBegin, changedJEnd);
+        resetChanged();
+    }
+
+    /**
+     * Marks the cell (i, j) as changed in the current timestep.
+     */
+    void markChanged(int i, int j) {
+        changedIBegin = std::min(changedIBegin, i);
+        changedIEnd = std::max(changedIEnd, i + 1);
+        changedJBegin = std::min(changedJBegin, j);
+        changedJEnd = std::max(changedJEnd, j + 1);
+    }
+
+    /**
+     * Grows the box by the changed cells of the current timestep and their neighbours.
+     *
+     * @param h, hu, hv current cell values, used to bound the wave speeds outside of the box after the first timestep
+     * @param g gravity
+     */
+    template<typename Array>
+    void advance(const Array &h, const Array &hu, const Array &hv, float g) {
+        int grownIBegin = std::max(changedIBegin - 1, 1);
+        int grownIEnd = std::min(changedIEnd + 1, nx + 1);
+        int grownJBegin = std::max(changedJBegin - 1, 1);
+        int grownJEnd = std::min(changedJEnd + 1, ny + 1);
+        if (changedIBegin >= changedIEnd) {
+            // Nothing changed, the box stays empty
+            grownIBegin = grownIEnd = grownJBegin = grownJEnd = 1;
+        }
+
+        if (firstTimestep) {
+            // The first box may be smaller than the whole block
+            iBegin = grownIBegin;
+            iEnd = grownIEnd;
+            jBegin = grownJBegin;
+            jEnd = grownJEnd;
+            firstTimestep = false;
+
+            // Includes the ghost layer, which holds the initial state as well
+            outsideWaveSpeed = 0;
+            for (int i = 0; i < nx + 2; i++) {
+                for (int j = 0; j < ny + 2; j++) {
+                    if (!isInside(i, j) && h[i][j] > 0) {
+                        float momentum = std::max(std::abs(hu[i][j]), std::abs(hv[i][j]));
+                        outsideWaveSpeed = std::max(outsideWaveSpeed, (float) (momentum / h[i][j] + std::sqrt(g * h[i][j])));
+                    }
+                }
+            }
+        } else {
+            include(grownIBegin, grownIEnd, grownJBegin, grownJEnd);
+        }
+
+        resetChanged();
+    }
+
+private:
+    void checkGhostCell(double value, int k, int i, int j) {
+        if (!firstTimestep && ghostLayer[k] != value)
+            markChanged(i, j);
+        ghostLayer[k] = value;
+    }
+
+    bool isInside(int i, int j) const {
+        return i >= iBegin && i < iEnd && j >= jBegin && j < jEnd;
+    }
+
+    void include(int otherIBegin, int otherIEnd, int otherJBegin, int otherJEnd) {
+        if (otherIBegin >= otherIEnd || otherJBegin >= otherJEnd)
+            return;
+        if (iBegin >= iEnd || jBegin >= jEnd) {
+            iBegin = otherIBegin;
+            iEnd = otherIEnd;
+            jBegin = otherJBegin;
+            jEnd = otherJEnd;
+            return;
+        }
+
+        iBegin = std::min(iBegin, otherIBegin);
+        iEnd = std::max(iEnd, otherIEnd);
+        jBegin = std::min(jBegin, otherJBegin);
+        jEnd = std::max(jEnd, otherJEnd);
+    }
+
+    void resetChanged() {
+        changedIBegin = nx + 1;
+        changedIEnd = 1;
+        changedJBegin = ny + 1;
+        changedJEnd = 1;
+    }
+
+    int nx;
+    int ny;
+
+    int iBegin;
+    int iEnd;
+    int jBegin;
+    int jEnd;
+
+    // Bounding box of the cells changed in the current timestep
+    int changedIBegin;
+    int changedIEnd;
+    int changedJBegin;
+    int changedJEnd;
+
+    bool firstTimestep;
+    float outsideWaveSpeed;
+
+    // Ghost layer of h, hu and hv of the previous timestep, double holds every state storage type exactly
+    std::vector<double> ghostLayer;
+};
+
+#endif // __WAVEFRONTBOX_HH
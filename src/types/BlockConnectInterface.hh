@@ -2,6 +2,7 @@
 #define __BLOCKCONNECTINTERFACE_HH
 
 #include "types/Boundary.hh"
+#include "tools/SimulationTime.hh"
 
 #ifdef UPCXX
 #include <upcxx/upcxx.hpp>
@@ -17,8 +18,8 @@ struct BlockConnectInterface {
     T pointerB;
     T pointerHu;
     T pointerHv;
-    T pointerTimestep;
 #ifdef UPCXX
+    upcxx::global_ptr<TimeScalar> pointerTimestep;
     upcxx::global_ptr<std::atomic<bool>> dataTransmitted;
     upcxx::global_ptr<std::atomic<bool>> dataReady;
     upcxx::global_ptr<int> iteration;